@@ -73,6 +73,11 @@ def define_options(parser):
                       choices=['fixed', 'flexible'], help="'fixed'|'flexible'")
     parser.add_option("--network-fault-model", action="store_true", default=False,
                       help="enable network fault model: see src/mem/ruby/network/fault_model/")
+    parser.add_option("--ruby-event-queues", type="int", default=1,
+                      help="split the routers of the simple network, and \
+                            the controllers attached to them, across this \
+                            many event queues. CPUs have to be placed on \
+                            the event queue of their sequencer.")
 
     # ruby mapping options
     parser.add_option("--numa-high-bit", type="int", default=0,
@@ -117,11 +122,18 @@ def setup_memory_controllers(system, ruby, dir_cntrls, options):
             crossbars.append(crossbar)
             dir_cntrl.memory = crossbar.slave
 
+        if crossbar != None and options.ruby_event_queues > 1:
+            crossbar.eventq_index = dir_cntrl.eventq_index
+
         for r in system.mem_ranges:
             mem_ctrl = MemConfig.create_mem_ctrl(
                 MemConfig.get(options.mem_type), r, index, options.num_dirs,
                 int(math.log(options.num_dirs, 2)), options.cacheline_size)
 
+            # the memory port of the directory is not a network link
+            if options.ruby_event_queues > 1:
+                mem_ctrl.eventq_index = dir_cntrl.eventq_index
+
             mem_ctrls.append(mem_ctrl)
 
             if crossbar != None:
@@ -147,6 +159,24 @@ def create_topology(controllers, options):
     topology = eval("Topo.%s(controllers)" % options.topology)
     return topology
 
+def partition_event_queues(options, network):
+    """ Spread the routers of a simple network evenly over the event
+        queues, and put every controller (and its sequencer) on the event
+        queue of the router it is attached to. Messages then only cross
+        event queues over links between routers, or from a router to a
+        controller, whose latency bounds the simulation quantum.
+    """
+    num_queues = options.ruby_event_queues
+    routers = network.routers
+    for (i, router) in enumerate(routers):
+        router.eventq_index = i * num_queues / len(routers)
+
+    for link in network.ext_links:
+        cntrl = link.ext_node
+        cntrl.eventq_index = link.int_node.eventq_index
+        if hasattr(cntrl, "sequencer"):
+            cntrl.sequencer.eventq_index = cntrl.eventq_index
+
 def create_system(options, full_system, system, piobus = None, dma_ports = []):
 
     system.ruby = RubySystem()
@@ -211,6 +241,11 @@ def create_system(options, full_system, system, piobus = None, dma_ports = []):
         assert(RouterClass == Switch)
         network.setup_buffers()
 
+    if options.ruby_event_queues > 1:
+        if options.garnet_network is not None:
+            fatal("Only the simple network can be split across event queues")
+        partition_event_queues(options, network)
+
     if InterfaceClass != None:
         netifs = [InterfaceClass(id=i) for (i,n) in enumerate(network.ext_links)]
         network.netifs = netifs
@@ -41,18 +41,20 @@ StaticInstPtr
 BasicDecodeCache::decode(TheISA::Decoder *decoder,
         TheISA::ExtMachInst mach_inst, Addr addr)
 {
-    StaticInstPtr &si = decodePages.lookup(addr);
+    Tables &tables = DecodeCache::PerThread<Tables>::get();
+
+    StaticInstPtr &si = tables.decodePages.lookup(addr);
     if (si && (si->machInst == mach_inst))
         return si;
 
-    DecodeCache::InstMap::iterator iter = instMap.find(mach_inst);
-    if (iter != instMap.end()) {
+    DecodeCache::InstMap::iterator iter = tables.instMap.find(mach_inst);
+    if (iter != tables.instMap.end()) {
         si = iter->second;
         return si;
     }
 
     si = decoder->decodeInst(mach_inst);
-    instMap[mach_inst] = si;
+    tables.instMap[mach_inst] = si;
     return si;
 }
 
@@ -44,11 +44,19 @@ namespace TheISA
 namespace GenericISA
 {
 
+/// Cache of decoded instructions shared by all the decoders of a host
+/// thread. Instructions are looked up by address first and checked
+/// against the machine instruction found there, which also catches
+/// code that has been written to since it was decoded, and then by
+/// machine instruction.
 class BasicDecodeCache
 {
   private:
-    DecodeCache::InstMap instMap;
-    DecodeCache::AddrMap<StaticInstPtr> decodePages;
+    struct Tables
+    {
+        DecodeCache::InstMap instMap;
+        DecodeCache::AddrMap<StaticInstPtr> decodePages;
+    };
 
   public:
     /// Decode a machine instruction.
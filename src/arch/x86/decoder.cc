@@ -641,11 +641,14 @@ Decoder::doImmediateState()
 }
 
 Decoder::InstBytes Decoder::dummy;
-Decoder::InstCacheMap Decoder::instCacheMap;
 
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
+    // The mode may have been set up from another thread
+    if (instCacheMap != &InstCacheMaps::get())
+        updateInstMap();
+
     DecodeCache::InstMap::iterator iter = instMap->find(mach_inst);
     if (iter != instMap->end())
         return iter->second;
@@ -229,7 +229,28 @@ class Decoder
 
     DecodeCache::InstMap *instMap;
     typedef std::unordered_map<CacheKey, DecodeCache::InstMap *> InstCacheMap;
-    static InstCacheMap instCacheMap;
+    typedef DecodeCache::PerThread<InstCacheMap> InstCacheMaps;
+
+    /// The per thread InstCacheMap which instMap belongs to, and its key
+    /// in there.
+    InstCacheMap *instCacheMap;
+    CacheKey instMapKey;
+
+    /// Find the InstMap of the current mode in the InstCacheMap of the
+    /// calling thread.
+    void
+    updateInstMap()
+    {
+        instCacheMap = &InstCacheMaps::get();
+
+        InstCacheMap::iterator imIter = instCacheMap->find(instMapKey);
+        if (imIter != instCacheMap->end()) {
+            instMap = imIter->second;
+        } else {
+            instMap = new DecodeCache::InstMap;
+            (*instCacheMap)[instMapKey] = instMap;
+        }
+    }
 
   public:
     Decoder(ISA* isa = nullptr) : basePC(0), origPC(0), offset(0),
@@ -249,6 +270,8 @@ class Decoder
         instBytes = &dummy;
         decodePages = NULL;
         instMap = NULL;
+        instCacheMap = NULL;
+        instMapKey = 0;
     }
 
     void setM5Reg(HandyM5Reg m5Reg)
@@ -271,13 +294,8 @@ class Decoder
             addrCacheMap[m5Reg] = decodePages;
         }
 
-        InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
-        if (imIter != instCacheMap.end()) {
-            instMap = imIter->second;
-        } else {
-            instMap = new DecodeCache::InstMap;
-            instCacheMap[m5Reg] = instMap;
-        }
+        instMapKey = m5Reg;
+        updateInstMap();
     }
 
     void takeOverFrom(Decoder *old)
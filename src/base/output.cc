@@ -32,6 +32,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <cassert>
@@ -49,6 +50,42 @@ using namespace std;
 
 OutputDirectory simout;
 
+namespace {
+
+/**
+ * Point every file descriptor open on a file at /dev/null instead, so
+ * that whatever is still written through them does not reach the
+ * file.
+ */
+void
+detachFile(const string &filename)
+{
+    struct stat file;
+    if (stat(filename.c_str(), &file))
+        return;
+
+    int null_fd = open("/dev/null", O_WRONLY);
+    DIR *fds = opendir("/dev/fd");
+    if (null_fd < 0 || !fds)
+        fatal("Cannot detach file %s", filename);
+
+    while (struct dirent *entry = readdir(fds)) {
+        char *end;
+        long fd = strtol(entry->d_name, &end, 10);
+        struct stat st;
+        if (*end || end == entry->d_name || fd == null_fd ||
+            fstat(fd, &st))
+            continue;
+        if (st.st_dev == file.st_dev && st.st_ino == file.st_ino)
+            dup2(null_fd, fd);
+    }
+
+    closedir(fds);
+    close(null_fd);
+}
+
+} // anonymous namespace
+
 /**
  * @file This file manages creating / deleting output files for the simulator.
  */
@@ -137,6 +174,56 @@ OutputDirectory::setDirectory(const string &d)
         dir += PATH_SEPARATOR;
 }
 
+void
+OutputDirectory::relocate(const string &d)
+{
+    string old_dir = directory();
+
+    dir.clear();
+    setDirectory(d);
+
+    map_t old_files;
+    old_files.swap(files);
+    for (auto &f : old_files) {
+        string filename = f.first;
+        if (filename.compare(0, old_dir.size(), old_dir) == 0)
+            filename = dir + filename.substr(old_dir.size());
+        else
+            warn("Reopening %s, which is outside of the output directory\n",
+                 filename);
+
+        ofstream *fs = dynamic_cast<ofstream*>(f.second);
+        if (fs) {
+            // the parent flushed the stream before forking, so
+            // closing our copy of it does not touch its file
+            fs->close();
+            fs->open(filename.c_str(), ios::trunc | ios::binary);
+            if (!fs->is_open())
+                fatal("Cannot open file %s", filename);
+        } else {
+            ogzstream *gfs = dynamic_cast<ogzstream*>(f.second);
+            assert(gfs);
+            // Closing a compressed stream writes out its trailer,
+            // which must not end up in the file of the parent.
+            detachFile(f.first);
+            gfs->close();
+            gfs->clear();
+            gfs->open(filename.c_str(), ios::out | ios::trunc);
+            if (!gfs->is_open())
+                fatal("Cannot open file %s", filename);
+        }
+
+        files[filename] = f.second;
+    }
+}
+
+void
+OutputDirectory::flush()
+{
+    for (auto &f : files)
+        f.second->flush();
+}
+
 const string &
 OutputDirectory::directory() const
 {
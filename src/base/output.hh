@@ -97,6 +97,21 @@ class OutputDirectory
      */
     void setDirectory(const std::string &dir);
 
+    /**
+     * Move this directory, reopening every file opened through it in
+     * the new directory. The streams are reopened in place, so the
+     * pointers held by their users stay valid. This is used by a
+     * forked simulator to stop writing to the files of its parent.
+     * Redirected stdout and stderr are not streams of the directory,
+     * m5.fork() moves them.
+     *
+     * @param dir name of the new directory
+     */
+    void relocate(const std::string &dir);
+
+    /** Flush all files opened through this directory. */
+    void flush();
+
     /**
      * Gets name of this directory.
      * @return name of this directory
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOC_HH__
+#define __BASE_POOL_ALLOC_HH__
+
+/**
+ * @file base/pool_alloc.hh
+ *
+ * Free-list backed allocation for small objects that are allocated
+ * and freed at a high rate, such as packets and requests.
+ *
+ * Every thread keeps its own free list for each block size, so no
+ * locking is needed. A block freed by a different thread than the one
+ * that allocated it simply moves to the freeing thread's list. The
+ * free lists are bounded so that a thread that mostly frees blocks
+ * allocated elsewhere does not hoard memory.
+ *
+ * Building with USE_POOL_ALLOC=False turns all of this into plain
+ * new/delete, which is what memory debuggers such as valgrind want
+ * to see.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "base/intmath.hh"
+#include "config/use_pool_alloc.hh"
+
+/**
+ * Per-thread free list of memory blocks of a fixed size.
+ */
+template <size_t BlockSize>
+class FreeList
+{
+  private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    static_assert(BlockSize >= sizeof(Block), "Block size too small");
+
+    /** Maximum number of blocks kept on the free list of a thread. */
+    static const size_t maxFree = 1 << 14;
+
+    static __thread Block *head;
+    static __thread size_t numFree;
+
+  public:
+    static void *
+    allocate()
+    {
+        if (!head)
+            return ::operator new(BlockSize);
+
+        Block *block = head;
+        head = block->next;
+        --numFree;
+        return block;
+    }
+
+    static void
+    release(void *p)
+    {
+        if (numFree == maxFree) {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *block = static_cast<Block *>(p);
+        block->next = head;
+        head = block;
+        ++numFree;
+    }
+
+    /**
+     * Fill the free list of the calling thread with at least the
+     * given number of blocks, up to the bound on its length.
+     */
+    static void
+    reserve(size_t num)
+    {
+        while (numFree < num && numFree < maxFree)
+            release(::operator new(BlockSize));
+    }
+};
+
+template <size_t BlockSize>
+__thread typename FreeList<BlockSize>::Block *FreeList<BlockSize>::head =
+    nullptr;
+
+template <size_t BlockSize>
+__thread size_t FreeList<BlockSize>::numFree = 0;
+
+/**
+ * Derive from PoolAllocated<T> to allocate T objects from a free
+ * list. Objects of derived classes of a different size fall back to
+ * the global operator new.
+ */
+template <class T>
+class PoolAllocated
+{
+#if USE_POOL_ALLOC
+  public:
+    static void *
+    operator new(size_t size)
+    {
+        if (size != sizeof(T))
+            return ::operator new(size);
+        return FreeList<sizeof(T)>::allocate();
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        if (size != sizeof(T))
+            ::operator delete(p);
+        else
+            FreeList<sizeof(T)>::release(p);
+    }
+#endif
+
+    /**
+     * Make sure that the given number of T objects can be allocated
+     * by the calling thread without going to the global allocator.
+     */
+    static void
+    reserve(size_t num)
+    {
+#if USE_POOL_ALLOC
+        FreeList<sizeof(T)>::reserve(num);
+#endif
+    }
+};
+
+/**
+ * Allocation of byte buffers, such as packet payloads. Sizes up to
+ * maxPooledBuffer are rounded up to a power of two and served from the
+ * corresponding free list, larger ones come from new[].
+ */
+namespace BufferPool
+{
+
+const size_t maxPooledBuffer = 256;
+
+/** Size class of a pooled buffer, buffers of 8 bytes or less are 0. */
+inline int
+sizeClass(size_t size)
+{
+    return size <= 8 ? 0 : ceilLog2(size) - 3;
+}
+
+inline uint8_t *
+allocate(size_t size)
+{
+#if USE_POOL_ALLOC
+    if (size <= maxPooledBuffer) {
+        switch (sizeClass(size)) {
+          case 0: return static_cast<uint8_t *>(FreeList<8>::allocate());
+          case 1: return static_cast<uint8_t *>(FreeList<16>::allocate());
+          case 2: return static_cast<uint8_t *>(FreeList<32>::allocate());
+          case 3: return static_cast<uint8_t *>(FreeList<64>::allocate());
+          case 4: return static_cast<uint8_t *>(FreeList<128>::allocate());
+          case 5: return static_cast<uint8_t *>(FreeList<256>::allocate());
+        }
+    }
+#endif
+    return new uint8_t[size];
+}
+
+/**
+ * Free a buffer obtained from allocate(). The size must be the one
+ * the buffer was allocated with.
+ */
+inline void
+release(uint8_t *buf, size_t size)
+{
+#if USE_POOL_ALLOC
+    if (size <= maxPooledBuffer) {
+        switch (sizeClass(size)) {
+          case 0: FreeList<8>::release(buf); return;
+          case 1: FreeList<16>::release(buf); return;
+          case 2: FreeList<32>::release(buf); return;
+          case 3: FreeList<64>::release(buf); return;
+          case 4: FreeList<128>::release(buf); return;
+          case 5: FreeList<256>::release(buf); return;
+        }
+    }
+#endif
+    delete [] buf;
+}
+
+} // namespace BufferPool
+
+#endif // __BASE_POOL_ALLOC_HH__
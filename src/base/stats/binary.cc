@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "base/stats/binary.hh"
+#include "base/stats/info.hh"
+#include "base/misc.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+
+using namespace std;
+
+namespace Stats {
+
+namespace {
+
+const char magic[8] = { 'g', 'e', 'm', '5', 's', 't', 'a', 't' };
+const uint32_t byteOrderMark = 0x01020304;
+const uint8_t zlibCompressed = 0x1;
+
+/** Number of fixed values stored ahead of the buckets of a dist. */
+const size_t distHeader = 11;
+
+template <class T>
+void
+put(string &buf, T value)
+{
+    buf.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+putString(string &buf, const string &str)
+{
+    put<uint32_t>(buf, str.size());
+    buf.append(str);
+}
+
+const string &
+entry(const vector<string> &names, off_type i)
+{
+    static const string empty;
+    return i < names.size() ? names[i] : empty;
+}
+
+size_t
+distValues(const DistData &data)
+{
+    return distHeader + data.cvec.size();
+}
+
+} // anonymous namespace
+
+Binary::Binary()
+    : mystream(false), stream(NULL), compress(false), cur(0),
+      schemaDirty(true)
+{
+}
+
+Binary::Binary(const std::string &file, bool compress)
+    : mystream(false), stream(NULL), compress(false), cur(0),
+      schemaDirty(true)
+{
+    open(file, compress);
+}
+
+Binary::~Binary()
+{
+    if (mystream) {
+        assert(stream);
+        delete stream;
+    }
+}
+
+void
+Binary::open(std::ostream &_stream, bool _compress)
+{
+    if (stream)
+        panic("stream already set!");
+
+    mystream = false;
+    stream = &_stream;
+    compress = _compress;
+    if (!valid())
+        fatal("Unable to open output stream for writing\n");
+
+    writeHeader();
+}
+
+void
+Binary::open(const std::string &file, bool _compress)
+{
+    if (stream)
+        panic("stream already set!");
+
+    mystream = true;
+    stream = new ofstream(file.c_str(), ios::trunc | ios::binary);
+    compress = _compress;
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+
+    writeHeader();
+}
+
+bool
+Binary::valid() const
+{
+    return stream != NULL && stream->good();
+}
+
+void
+Binary::reopen()
+{
+    if (!valid())
+        return;
+
+    // the new file starts out empty, so it needs the header and the
+    // schema again before the next row
+    writeHeader();
+    schemaDirty = true;
+}
+
+void
+Binary::writeHeader()
+{
+    string header(magic, sizeof(magic));
+    put<uint32_t>(header, version);
+    put<uint32_t>(header, byteOrderMark);
+    stream->write(header.data(), header.size());
+}
+
+void
+Binary::writeRecord(char kind, const string &payload)
+{
+    const char *data = payload.data();
+    size_t stored = payload.size();
+    uint8_t flags = 0;
+
+    if (compress) {
+        uLongf zsize = compressBound(payload.size());
+        zbuf.resize(zsize);
+        int ret = compress2(&zbuf[0], &zsize,
+                            (const Bytef *)payload.data(), payload.size(),
+                            Z_BEST_SPEED);
+        if (ret != Z_OK)
+            panic("Unable to compress statistics record (%d)\n", ret);
+
+        // Rows of mostly unchanged counters compress very well, but
+        // don't bother if the payload wouldn't get any smaller.
+        if (zsize < payload.size()) {
+            data = (const char *)&zbuf[0];
+            stored = zsize;
+            flags |= zlibCompressed;
+        }
+    }
+
+    string header;
+    put<uint8_t>(header, kind);
+    put<uint8_t>(header, flags);
+    put<uint16_t>(header, 0);
+    put<uint32_t>(header, payload.size());
+    put<uint32_t>(header, stored);
+
+    stream->write(header.data(), header.size());
+    stream->write(data, stored);
+}
+
+void
+Binary::begin()
+{
+    cur = 0;
+    row.clear();
+    tail.clear();
+    put<uint64_t>(row, curTick());
+}
+
+void
+Binary::end()
+{
+    if (cur != schema.size()) {
+        schema.resize(cur);
+        schemaDirty = true;
+    }
+
+    if (schemaDirty) {
+        string payload;
+        put<uint32_t>(payload, schema.size());
+        putString(payload, Info::separatorString);
+        for (size_t i = 0; i < schema.size(); ++i)
+            payload.append(schema[i].desc);
+
+        writeRecord('S', payload);
+        schemaDirty = false;
+    }
+
+    row.append(tail);
+    writeRecord('D', row);
+    stream->flush();
+}
+
+bool
+Binary::noOutput(const Info &info)
+{
+    // Unlike the text output, stats whose prerequisite is zero are
+    // still written so that every row has the same layout. The
+    // prerequisites are cheap to apply when reading the file back.
+    return !info.flags.isSet(display);
+}
+
+string *
+Binary::expect(const Info &info, StatKind kind, size_t values)
+{
+    size_t pos = cur++;
+
+    if (pos < schema.size()) {
+        const Column &col = schema[pos];
+        if (col.id == info.id && col.kind == kind && col.values == values)
+            return NULL;
+    } else {
+        schema.resize(pos + 1);
+    }
+
+    schemaDirty = true;
+
+    Column &col = schema[pos];
+    col.id = info.id;
+    col.kind = kind;
+    col.values = values;
+    col.desc.clear();
+
+    put<uint8_t>(col.desc, kind);
+    put<int32_t>(col.desc, info.id);
+    put<uint16_t>(col.desc, info.flags);
+    put<int32_t>(col.desc, info.precision);
+    putString(col.desc, info.name);
+    putString(col.desc, info.desc);
+
+    return &col.desc;
+}
+
+void
+Binary::appendValue(Result value)
+{
+    put<double>(row, value);
+}
+
+void
+Binary::appendDist(const DistData &data)
+{
+    appendValue(data.samples);
+    appendValue(data.sum);
+    appendValue(data.squares);
+    appendValue(data.logs);
+    appendValue(data.min_val);
+    appendValue(data.max_val);
+    appendValue(data.underflow);
+    appendValue(data.overflow);
+    appendValue(data.min);
+    appendValue(data.max);
+    appendValue(data.bucket_size);
+    row.append(reinterpret_cast<const char *>(data.cvec.data()),
+               data.cvec.size() * sizeof(Counter));
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    expect(info, ScalarKind, 1);
+    appendValue(info.result());
+}
+
+void
+Binary::visitVector(const VectorInfo &info, StatKind kind)
+{
+    if (noOutput(info))
+        return;
+
+    const VResult &vec = info.result();
+    size_type size = vec.size();
+
+    string *desc = expect(info, kind, size);
+    if (desc) {
+        put<uint32_t>(*desc, size);
+        for (off_type i = 0; i < size; ++i) {
+            putString(*desc, entry(info.subnames, i));
+            putString(*desc, entry(info.subdescs, i));
+        }
+    }
+
+    row.append(reinterpret_cast<const char *>(vec.data()),
+               size * sizeof(Result));
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    visitVector(info, VectorKind);
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    visitVector(info, FormulaKind);
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const DistData &data = info.data;
+
+    string *desc = expect(info, DistKind, distValues(data));
+    if (desc) {
+        put<uint8_t>(*desc, data.type);
+        put<uint32_t>(*desc, data.cvec.size());
+    }
+
+    appendDist(data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    size_type size = info.size();
+    size_t values = 0;
+    for (off_type i = 0; i < size; ++i)
+        values += distValues(info.data[i]);
+
+    string *desc = expect(info, VectorDistKind, values);
+    if (desc) {
+        put<uint32_t>(*desc, size);
+        for (off_type i = 0; i < size; ++i) {
+            putString(*desc, entry(info.subnames, i));
+            putString(*desc, entry(info.subdescs, i));
+            put<uint8_t>(*desc, info.data[i].type);
+            put<uint32_t>(*desc, info.data[i].cvec.size());
+        }
+    }
+
+    for (off_type i = 0; i < size; ++i)
+        appendDist(info.data[i]);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    size_t values = info.x * info.y;
+    assert(info.cvec.size() == values);
+
+    string *desc = expect(info, Vector2dKind, values);
+    if (desc) {
+        put<uint32_t>(*desc, info.x);
+        put<uint32_t>(*desc, info.y);
+        for (off_type i = 0; i < info.x; ++i) {
+            putString(*desc, entry(info.subnames, i));
+            putString(*desc, entry(info.subdescs, i));
+        }
+        for (off_type j = 0; j < info.y; ++j)
+            putString(*desc, entry(info.y_subnames, j));
+    }
+
+    row.append(reinterpret_cast<const char *>(info.cvec.data()),
+               values * sizeof(Counter));
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    // The number of buckets of a sparse histogram changes from dump
+    // to dump. Only the number of samples and of (bucket, count) pairs
+    // are stored in place, the pairs themselves go to the end of the
+    // row so that all other values stay at fixed offsets.
+    expect(info, SparseHistKind, 2);
+
+    const SparseHistData &data = info.data;
+    appendValue(data.samples);
+    appendValue(data.cmap.size());
+
+    MCounter::const_iterator it;
+    for (it = data.cmap.begin(); it != data.cmap.end(); ++it) {
+        put<double>(tail, it->first);
+        put<double>(tail, it->second);
+    }
+}
+
+Output *
+initBinary(const string &filename, bool compress)
+{
+    static Binary binary;
+    static bool connected = false;
+
+    if (!connected) {
+        ostream *os = simout.find(filename);
+        if (!os)
+            os = simout.create(filename, true);
+
+        binary.open(*os, compress);
+        connected = true;
+    }
+
+    return &binary;
+}
+
+} // namespace Stats
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Columnar binary statistics output
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+class Info;
+struct DistData;
+
+/**
+ * Binary statistics output meant for long runs with frequent periodic
+ * dumps, where formatting stats.txt dominates the dump time.
+ *
+ * The stream starts with a short header followed by a sequence of
+ * records. A schema record describes every displayed stat (name,
+ * description, flags, subnames and the shape of its data) and is only
+ * written when the set or shape of the stats changes, which in
+ * practice means once. Every dump then appends a single data record
+ * holding the tick of the dump followed by the raw values of all stats
+ * in schema order as native doubles. Only the buckets of sparse
+ * histograms vary in number, they are appended at the end of the row
+ * so that every other value sits at the same offset in every row.
+ * Derived values (means, standard deviations, totals, pdf/cdf) are
+ * left to the reader, see m5/stats/binary.py.
+ *
+ * Layout, all integers in host byte order:
+ *   header: "gem5stat" magic, uint32 version, uint32 byte order mark
+ *   record: uint8 kind ('S' schema, 'D' data), uint8 flags (bit 0 is
+ *           set if the payload is zlib compressed), uint16 reserved,
+ *           uint32 raw payload size, uint32 stored payload size,
+ *           stored payload
+ */
+class Binary : public Output
+{
+  public:
+    /** Kind of stat, as recorded in the schema. */
+    enum StatKind {
+        ScalarKind = 0,
+        VectorKind,
+        DistKind,
+        VectorDistKind,
+        Vector2dKind,
+        FormulaKind,
+        SparseHistKind,
+    };
+
+    static const uint32_t version = 1;
+
+  protected:
+    /**
+     * Schema entry of a single stat. Only the fields needed to detect
+     * a change of shape are kept; the serialized description lives in
+     * the entry's record fragment.
+     */
+    struct Column
+    {
+        int id;
+        StatKind kind;
+        /** Number of values in the fixed part of a data row. */
+        size_t values;
+        /** Serialized schema fragment for this stat. */
+        std::string desc;
+    };
+
+    bool mystream;
+    std::ostream *stream;
+
+    /** Compress records with zlib. */
+    bool compress;
+
+    /** Schema of the last dump, one entry per displayed stat. */
+    std::vector<Column> schema;
+
+    /** Position in the schema of the stat being visited. */
+    size_t cur;
+
+    /** Set if the schema needs to be written before the next row. */
+    bool schemaDirty;
+
+    /** Data row being assembled. */
+    std::string row;
+
+    /** Variable length part of the row (sparse histogram buckets). */
+    std::string tail;
+
+    /** Scratch buffer for compressed payloads. */
+    std::vector<unsigned char> zbuf;
+
+    bool noOutput(const Info &info);
+
+    /**
+     * Check the next stat against its schema entry, rebuilding the
+     * entry if the stat changed. Returns the schema fragment the
+     * caller has to fill in with the stat specific part of the
+     * description, or NULL if the entry is up to date.
+     */
+    std::string *expect(const Info &info, StatKind kind, size_t values);
+
+    void writeHeader();
+    void writeRecord(char kind, const std::string &payload);
+
+    void appendValue(Result value);
+    void appendDist(const DistData &data);
+    void visitVector(const VectorInfo &info, StatKind kind);
+
+  public:
+    Binary();
+    Binary(const std::string &file, bool compress);
+    ~Binary();
+
+    void open(std::ostream &stream, bool compress);
+    void open(const std::string &file, bool compress);
+
+    // Implement Visit
+    virtual void visit(const ScalarInfo &info);
+    virtual void visit(const VectorInfo &info);
+    virtual void visit(const DistInfo &info);
+    virtual void visit(const VectorDistInfo &info);
+    virtual void visit(const Vector2dInfo &info);
+    virtual void visit(const FormulaInfo &info);
+    virtual void visit(const SparseHistInfo &info);
+
+    // Implement Output
+    virtual bool valid() const;
+    virtual void reopen();
+    virtual void begin();
+    virtual void end();
+};
+
+Output *initBinary(const std::string &filename, bool compress);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -52,6 +52,14 @@ struct Output
     virtual void end() = 0;
     virtual bool valid() const = 0;
 
+    /**
+     * Notify the output that its stream was reopened on a new, empty
+     * file, e.g., in the child of a fork. Outputs that start their
+     * file with a header or only write some records once have to write
+     * them again.
+     */
+    virtual void reopen() {}
+
     virtual void visit(const ScalarInfo &info) = 0;
     virtual void visit(const VectorInfo &info) = 0;
     virtual void visit(const DistInfo &info) = 0;
@@ -88,9 +88,6 @@ class BaseDynInst : public ExecContext, public RefCounted
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef RefCountingPtr<BaseDynInst<Impl> > BaseDynInstPtr;
 
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     enum {
         MaxInstSrcRegs = TheISA::MaxInstSrcRegs,        /// Max source regs
         MaxInstDestRegs = TheISA::MaxInstDestRegs       /// Max dest regs
@@ -196,8 +193,10 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
+    /** Position of this BaseDynInst in the window of all insts of its
+     *  thread.
+     */
+    uint64_t instListPos;
 
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
@@ -846,11 +845,15 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** Has this instruction generated a memory request. */
     bool hasRequest() { return instFlags[ReqMade]; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
+    /** Returns the position of this instruction in the window of all
+     *  insts of its thread.
+     */
+    uint64_t getInstListPos() const { return instListPos; }
 
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
+    /** Sets the position of this instruction in the window of all insts
+     *  of its thread.
+     */
+    void setInstListPos(uint64_t pos) { instListPos = pos; }
 
   public:
     /** Returns the number of consecutive store conditional failures. */
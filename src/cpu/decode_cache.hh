@@ -125,6 +125,32 @@ class AddrMap
     }
 };
 
+/// Decode cache tables of type Tables, one set for each host thread
+/// and shared by all the decoders which run on it. StaticInsts are
+/// reference counted with plain integers, so a StaticInst must never
+/// be handed to decoders on more than one thread. Keeping a set of
+/// tables per thread guarantees that without any locking, and only
+/// takes more memory when more than one thread simulates.
+template<class Tables>
+class PerThread
+{
+  protected:
+    static __thread Tables *tables;
+
+  public:
+    /// Get the tables of the calling thread, creating them if needed.
+    static Tables &
+    get()
+    {
+        if (!tables)
+            tables = new Tables;
+        return *tables;
+    }
+};
+
+template<class Tables>
+__thread Tables *PerThread<Tables>::tables = NULL;
+
 } // namespace DecodeCache
 
 #endif // __CPU_DECODE_CACHE_HH__
@@ -265,6 +265,12 @@ class MinorCPU(BaseCPU):
 
     enableIdling = Param.Bool(True,
         "Enable cycle skipping when the processor is idle\n");
+    enableStallSkipping = Param.Bool(False,
+        "Skip the cycles in which the pipeline only waits for insts. to"
+        " reach the end of their FUs (needs enableIdling)")
+    checkStallSkipping = Param.Bool(False,
+        "Tick through the cycles enableStallSkipping would skip and panic"
+        " if any of them does more than advance the FUs")
 
     branchPred = Param.BranchPredictor(TournamentBP(
         numThreads = Parent.numThreads), "Branch Predictor")
@@ -362,6 +362,23 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
             *pushWire = bubble;
         }
     }
+
+    /** The number of advances which will bring the non-bubble nearest
+     *  the end of an unstalled pipe to its end.  0 if there is no such
+     *  non-bubble */
+    unsigned int
+    advancesToPopable() const
+    {
+        if (stalled || occupancy == 0)
+            return 0;
+
+        for (int i = 1 - this->past; i <= 0; i++) {
+            if (!BubbleTraits::isBubble((*this)[i]))
+                return this->past + i;
+        }
+
+        return 0;
+    }
 };
 
 /** Base class for space reservation requestable objects */
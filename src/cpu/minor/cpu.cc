@@ -173,6 +173,8 @@ MinorCPU::wakeup(ThreadID tid)
 
     if (threads[tid]->status() == ThreadContext::Suspended)
         threads[tid]->activate();
+    else
+        pipeline->endStallSkip();
 
     DPRINTF(Drain,"Suspended Processor awoke\n");
 }
@@ -304,7 +306,7 @@ MinorCPU::wakeupOnEvent(unsigned int stage_id)
 
     /* Mark that some activity has taken place and start the pipeline */
     activityRecorder->activateStage(stage_id);
-    pipeline->start();
+    pipeline->wakeup();
 }
 
 MinorCPU *
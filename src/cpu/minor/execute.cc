@@ -94,7 +94,8 @@ Execute::Execute(const std::string &name_,
     instsBeingCommitted(params.executeCommitLimit),
     streamSeqNum(InstId::firstStreamSeqNum),
     lastPredictionSeqNum(InstId::firstPredictionSeqNum),
-    drainState(NotDraining)
+    drainState(NotDraining),
+    cyclesToFUOutput(0)
 {
     if (commitLimit < 1) {
         fatal("%s: executeCommitLimit must be >= 1 (%d)\n", name_,
@@ -1557,6 +1558,38 @@ Execute::evaluate()
             " advanceable FUs\n");
     }
 
+    /* If the FU pipelines moving is all that keeps us ticking, nothing
+     *  else can happen until an inst. reaches the end of one of them.
+     *  Mem refs stalled at the end of their FUs may leave early once
+     *  their dependencies are met so don't count on anything then */
+    cyclesToFUOutput = Cycles(0);
+    if (need_to_tick && !becoming_stalled && num_issued == 0 &&
+        !can_issue_next && !head_inst_might_commit &&
+        !lsq.needsToTick() && !interrupted && !getInput() &&
+        drainState == NotDraining && branch.isBubble())
+    {
+        unsigned int advances = 0;
+
+        for (unsigned int i = 0; i < numFuncUnits; i++) {
+            FUPipeline *fu = funcUnits[i];
+
+            if (fu->stalled && fu->front().inst->isMemRef()) {
+                advances = 0;
+                break;
+            }
+
+            unsigned int fu_advances = fu->advancesToPopable();
+
+            if (fu_advances != 0 &&
+                (advances == 0 || fu_advances < advances))
+            {
+                advances = fu_advances;
+            }
+        }
+
+        cyclesToFUOutput = Cycles(advances);
+    }
+
     /* Wake up if we need to tick again */
     if (need_to_tick)
         cpu.wakeupOnEvent(Pipeline::ExecuteStageId);
@@ -1598,6 +1631,17 @@ Execute::wakeupFetch(BranchData::Reason reason)
     cpu.wakeupOnEvent(Pipeline::ExecuteStageId);
 }
 
+void
+Execute::advanceFuncUnits(Cycles cycles)
+{
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        for (Cycles c(0); c < cycles; ++c)
+            fu->advance();
+    }
+}
+
 void
 Execute::minorTrace() const
 {
@@ -176,6 +176,11 @@ class Execute : public Named
     /** State progression for draining NotDraining -> ... -> DrainAllInsts */
     DrainState drainState;
 
+    /** Number of cycles from the last evaluate to the next one which can
+     *  do more than advance the FU pipelines, barring wakeups from outside
+     *  Execute.  0 if this isn't known.  Set by evaluate */
+    Cycles cyclesToFUOutput;
+
   protected:
     friend std::ostream &operator <<(std::ostream &os, DrainState state);
 
@@ -305,6 +310,14 @@ class Execute : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** Cycles until Execute has more to do than advance its FU pipelines,
+     *  as found by the last evaluate */
+    Cycles getCyclesToFUOutput() const { return cyclesToFUOutput; }
+
+    /** Advance the FU pipelines as the given number of evaluates in which
+     *  nothing but that happens would have */
+    void advanceFuncUnits(Cycles cycles);
+
     void minorTrace() const;
 
     /** After thread suspension, has Execute been drained of in-flight
@@ -56,6 +56,8 @@ Pipeline::Pipeline(MinorCPU &cpu_, MinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    enableStallSkipping(params.enableStallSkipping),
+    checkStallSkipping(params.checkStallSkipping),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -81,6 +83,10 @@ Pipeline::Pipeline(MinorCPU &cpu_, MinorCPUParams &params) :
         std::max(params.fetch2ToDecodeForwardDelay,
         std::max(params.decodeToExecuteForwardDelay,
         params.executeBranchDelay)))),
+    evaluating(false),
+    stallSkipped(false),
+    stallSkippedFrom(0),
+    stallCheckUntil(0),
     needToSignalDrained(false)
 {
     if (params.fetch1ToFetch2ForwardDelay < 1) {
@@ -102,6 +108,11 @@ Pipeline::Pipeline(MinorCPU &cpu_, MinorCPUParams &params) :
         fatal("%s: executeBranchDelay must be >= 1\n",
             cpu.name(), params.executeBranchDelay);
     }
+
+    if ((enableStallSkipping || checkStallSkipping) && !allow_idling) {
+        fatal("%s: enableStallSkipping and checkStallSkipping need"
+            " enableIdling\n", cpu.name());
+    }
 }
 
 void
@@ -122,6 +133,15 @@ Pipeline::minorTrace() const
 void
 Pipeline::evaluate()
 {
+    evaluating = true;
+
+    /* Catch up with the cycles skipped since the last evaluate */
+    if (stallSkipped) {
+        execute.advanceFuncUnits(
+            cpu.curCycle() - stallSkippedFrom - Cycles(1));
+        stallSkipped = false;
+    }
+
     /* Note that it's important to evaluate the stages in order to allow
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
@@ -144,6 +164,11 @@ Pipeline::evaluate()
      *  before the idler (which acts on the advice of the activity recorder */
     activityRecorder.evaluate();
 
+    /* Look for cycles to skip before the stages are deactivated */
+    Cycles stall_cycles(0);
+    if (enableStallSkipping || checkStallSkipping)
+        stall_cycles = cyclesToNextAction();
+
     if (allow_idling) {
         /* Become idle if we can but are not draining */
         if (!activityRecorder.active() && !needToSignalDrained) {
@@ -172,6 +197,51 @@ Pipeline::evaluate()
             stop();
         }
     }
+
+    if (checkStallSkipping) {
+        if (stallCheckUntil > cpu.curCycle()) {
+            /* This cycle would have been skipped and so must have left
+             *  the pipeline waiting for the same cycle */
+            if (cpu.curCycle() + stall_cycles != stallCheckUntil) {
+                panic("%s: Cycle %d would have been skipped but did more"
+                    " than advance the FU pipelines\n", cpu.name(),
+                    cpu.curCycle());
+            }
+        } else if (stall_cycles > 1) {
+            stallCheckUntil = cpu.curCycle() + stall_cycles;
+        }
+    } else if (enableStallSkipping && stall_cycles > 1 && running) {
+        DPRINTF(Quiesce, "Skipping %d cycles waiting for the FUs\n",
+            stall_cycles - 1);
+
+        stallSkipped = true;
+        stallSkippedFrom = cpu.curCycle();
+        deferTick(stall_cycles);
+    }
+
+    evaluating = false;
+}
+
+Cycles
+Pipeline::cyclesToNextAction()
+{
+    /* Only Execute can be active, and with no activity left in the
+     *  latches */
+    if (needToSignalDrained ||
+        !activityRecorder.getStageActive(ExecuteStageId) ||
+        activityRecorder.getActivityCount() != 1)
+    {
+        return Cycles(0);
+    }
+
+    /* The activity recorder doesn't cover the backward latch */
+    if (!f1ToF2.empty() || !f2ToF1.empty() || !f2ToD.empty() ||
+        !dToE.empty() || !eToF1.empty())
+    {
+        return Cycles(0);
+    }
+
+    return execute.getCyclesToFUOutput();
 }
 
 MinorCPU::MinorCPUPort &
@@ -192,6 +262,25 @@ Pipeline::wakeupFetch()
     execute.wakeupFetch();
 }
 
+void
+Pipeline::wakeup()
+{
+    if (!evaluating)
+        endStallSkip();
+
+    start();
+}
+
+void
+Pipeline::endStallSkip()
+{
+    stallCheckUntil = Cycles(0);
+
+    /* Bring the deferred tick forward */
+    if (running)
+        start();
+}
+
 bool
 Pipeline::drain()
 {
@@ -76,6 +76,14 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Allow cycles to be skipped when the pipeline is only waiting for
+     *  Execute's FU pipelines to deliver an instruction */
+    bool enableStallSkipping;
+
+    /** Tick through the cycles which stall skipping would skip and check
+     *  that they really do nothing else */
+    bool checkStallSkipping;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -92,6 +100,25 @@ class Pipeline : public Ticked
      *  cleanest place to initialise it */
     MinorActivityRecorder activityRecorder;
 
+    /** Is evaluate running?  Wakeups from the stages during evaluate don't
+     *  end a run of stall cycles */
+    bool evaluating;
+
+    /** Was the current tick deferred by stall skipping, and from which
+     *  cycle */
+    bool stallSkipped;
+    Cycles stallSkippedFrom;
+
+    /** With checkStallSkipping, the cycles before this one are expected
+     *  to do nothing but advance the FU pipelines.  0 if none are */
+    Cycles stallCheckUntil;
+
+  protected:
+    /** The number of cycles from the last evaluate to the next one which
+     *  can do more than advance Execute's FU pipelines.  0 if there may
+     *  be more to do in the next cycle */
+    Cycles cyclesToNextAction();
+
   public:
     /** Enumerated ids of the 'stages' for the activity recorder */
     enum StageId
@@ -114,6 +141,13 @@ class Pipeline : public Ticked
      *  after quiesce wakeup */
     void wakeupFetch();
 
+    /** Start ticking on an event, ending any run of stall cycles */
+    void wakeup();
+
+    /** End a run of stall cycles early without starting a stopped
+     *  pipeline */
+    void endStallSkip();
+
     /** Try to drain the CPU */
     bool drain();
 
@@ -127,6 +127,9 @@ class DerivO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(_defaultNumPhysCCRegs,
                                    "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqScheduler = Param.String('List', "IQ wakeup and select implementation "
+                               "(List: per op class ready lists, AgeMatrix: "
+                               "bit vectors and an age matrix)")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_AGE_MATRIX_HH__
+#define __CPU_O3_AGE_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "cpu/inst_seq.hh"
+#include "cpu/op_class.hh"
+
+/**
+ * Ready instructions of the instruction queue, kept in slots that are
+ * tracked with bit vectors: one vector of ready slots per op class,
+ * and an age matrix where row i has a bit set for every slot holding
+ * an instruction older than the one in slot i. The oldest instruction
+ * of any set of slots is then the one whose row does not intersect
+ * the set, which makes selecting the oldest ready instruction across
+ * op classes a handful of word operations per slot rather than a walk
+ * of sorted lists.
+ *
+ * A slot is taken when an instruction becomes ready and released when
+ * it is selected, so squashed instructions stay in their slot until
+ * select gets to them, just as they stay on the ready lists of the
+ * default scheduler. The number of slots grows if needed.
+ */
+template <class DynInstPtr>
+class AgeMatrix
+{
+  private:
+    typedef std::vector<uint64_t> BitVector;
+
+    /** Number of slots. */
+    unsigned numSlots;
+
+    /** Number of 64-bit words in a bit vector. */
+    unsigned numWords;
+
+    /** Instruction in each slot, NULL if the slot is free. */
+    std::vector<DynInstPtr> insts;
+
+    /** Sequence number of the instruction in each slot. */
+    std::vector<InstSeqNum> seqNums;
+
+    /** Op class of the instruction in each slot. */
+    std::vector<OpClass> opClasses;
+
+    /** Row of older slots for each slot, numWords words per row. */
+    BitVector age;
+
+    /** Occupied slots. */
+    BitVector used;
+
+    /** Ready slots of each op class. */
+    BitVector ready[Num_OpClasses];
+
+    /** Number of ready slots of each op class. */
+    unsigned numReady[Num_OpClasses];
+
+    /** Slots that can still be selected in the current select. */
+    BitVector selectable;
+
+    /** Total number of occupied slots. */
+    unsigned numUsed;
+
+    static bool test(const BitVector &v, unsigned i)
+    { return v[i / 64] & (1ULL << (i % 64)); }
+
+    static void set(BitVector &v, unsigned i)
+    { v[i / 64] |= 1ULL << (i % 64); }
+
+    static void clear(BitVector &v, unsigned i)
+    { v[i / 64] &= ~(1ULL << (i % 64)); }
+
+    uint64_t *row(unsigned slot) { return &age[slot * numWords]; }
+
+    /** Size all vectors for the given number of slots. */
+    void resize(unsigned num_slots);
+
+    /** Double the number of slots, keeping what is in them. */
+    void grow();
+
+  public:
+    /** Default construction. Must call init() prior to use. */
+    AgeMatrix() : numSlots(0), numWords(0), numUsed(0) { }
+
+    /** Set the initial number of slots and clear all of them. */
+    void init(unsigned num_slots);
+
+    /** Remove all instructions. */
+    void reset();
+
+    /** Add a ready instruction of the given op class. */
+    void insert(const DynInstPtr &inst, OpClass op_class);
+
+    /** Start a new select, with all ready instructions selectable. */
+    void startSelect() { selectable = used; }
+
+    /**
+     * Find the oldest of the selectable instructions.
+     *
+     * @return The slot of the instruction, or -1 if there is none.
+     */
+    int selectOldest();
+
+    /** Make the ready instructions of an op class unselectable for
+     *  the rest of the current select.
+     */
+    void block(OpClass op_class);
+
+    /** Remove the instruction in a slot. */
+    void remove(int slot);
+
+    const DynInstPtr &inst(int slot) const { return insts[slot]; }
+
+    OpClass opClass(int slot) const { return opClasses[slot]; }
+
+    /** Number of ready instructions of an op class. */
+    unsigned size(OpClass op_class) const { return numReady[op_class]; }
+
+    /** Checks if there are any ready instructions. */
+    bool empty() const { return numUsed == 0; }
+};
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::resize(unsigned num_slots)
+{
+    numSlots = num_slots;
+    numWords = (num_slots + 63) / 64;
+
+    insts.resize(numSlots);
+    seqNums.resize(numSlots);
+    opClasses.resize(numSlots);
+    age.assign(numSlots * numWords, 0);
+    used.assign(numWords, 0);
+    for (int i = 0; i < Num_OpClasses; ++i)
+        ready[i].assign(numWords, 0);
+    selectable.assign(numWords, 0);
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::init(unsigned num_slots)
+{
+    resize(num_slots);
+    reset();
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::reset()
+{
+    for (auto &inst : insts)
+        inst = NULL;
+    std::fill(used.begin(), used.end(), 0);
+    for (int i = 0; i < Num_OpClasses; ++i) {
+        std::fill(ready[i].begin(), ready[i].end(), 0);
+        numReady[i] = 0;
+    }
+    std::fill(selectable.begin(), selectable.end(), 0);
+    numUsed = 0;
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::grow()
+{
+    std::vector<DynInstPtr> old_insts;
+    old_insts.swap(insts);
+    std::vector<OpClass> old_op_classes(opClasses);
+
+    resize(numSlots * 2);
+    reset();
+
+    for (unsigned i = 0; i < old_insts.size(); ++i) {
+        if (old_insts[i])
+            insert(old_insts[i], old_op_classes[i]);
+    }
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::insert(const DynInstPtr &inst, OpClass op_class)
+{
+    if (numUsed == numSlots)
+        grow();
+
+    // take the first free slot
+    unsigned slot = 0;
+    for (unsigned w = 0; w < numWords; ++w) {
+        if (~used[w]) {
+            slot = w * 64 + __builtin_ctzll(~used[w]);
+            break;
+        }
+    }
+    assert(slot < numSlots && !test(used, slot));
+
+    InstSeqNum seq_num = inst->seqNum;
+    uint64_t *slot_row = row(slot);
+
+    // set up the row of the new slot, and its column in the rows of
+    // the others, the new instruction usually being the youngest
+    for (unsigned w = 0; w < numWords; ++w) {
+        uint64_t bits = used[w];
+        slot_row[w] = 0;
+        while (bits) {
+            unsigned other = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (seqNums[other] < seq_num) {
+                slot_row[w] |= 1ULL << (other % 64);
+                row(other)[slot / 64] &= ~(1ULL << (slot % 64));
+            } else {
+                row(other)[slot / 64] |= 1ULL << (slot % 64);
+            }
+        }
+    }
+
+    insts[slot] = inst;
+    seqNums[slot] = seq_num;
+    opClasses[slot] = op_class;
+    set(used, slot);
+    set(ready[op_class], slot);
+    ++numReady[op_class];
+    ++numUsed;
+}
+
+template <class DynInstPtr>
+int
+AgeMatrix<DynInstPtr>::selectOldest()
+{
+    for (unsigned w = 0; w < numWords; ++w) {
+        uint64_t bits = selectable[w];
+        while (bits) {
+            unsigned slot = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            // the oldest selectable instruction has no selectable
+            // instruction older than itself
+            const uint64_t *slot_row = row(slot);
+            bool oldest = true;
+            for (unsigned v = 0; v < numWords && oldest; ++v)
+                oldest = !(slot_row[v] & selectable[v]);
+            if (oldest)
+                return slot;
+        }
+    }
+    return -1;
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::block(OpClass op_class)
+{
+    for (unsigned w = 0; w < numWords; ++w)
+        selectable[w] &= ~ready[op_class][w];
+}
+
+template <class DynInstPtr>
+void
+AgeMatrix<DynInstPtr>::remove(int slot)
+{
+    assert(test(used, slot));
+
+    OpClass op_class = opClasses[slot];
+    insts[slot] = NULL;
+    clear(used, slot);
+    clear(ready[op_class], slot);
+    clear(selectable, slot);
+    --numReady[op_class];
+    --numUsed;
+}
+
+#endif // __CPU_O3_AGE_MATRIX_HH__
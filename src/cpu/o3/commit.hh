@@ -224,6 +224,17 @@ class DefaultCommit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Checks if commit would do nothing this cycle but find that the
+     * head of each ROB is not ready, i.e., it gets no new or completed
+     * instructions, has no squash, trap or interrupt to handle and has
+     * no ROB status to send back. If so, skipTick() can be called
+     * instead of tick().
+     */
+    bool canSkipTick();
+
+    /** Does what tick() would when canSkipTick() holds. */
+    void skipTick();
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -726,6 +726,54 @@ DefaultCommit<Impl>::tick()
     updateStatus();
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::canSkipTick()
+{
+    if (activeThreads->empty() || fromRename->size > 0 || fromIEW->size > 0 ||
+        interrupt != NoFault)
+        return false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (commitStatus[tid] != Running && commitStatus[tid] != Idle)
+            return false;
+
+        if (trapSquash[tid] || tcSquash[tid] || fromIEW->squash[tid] ||
+            rob->isHeadReady(tid))
+            return false;
+
+        // commit() would report the ROB as empty
+        if (checkEmptyROB[tid] && rob->isEmpty(tid) &&
+            !iewStage->hasStoresToWB(tid))
+            return false;
+    }
+
+    // Checked last as it asks the interrupt controller
+    if (FullSystem && cpu->checkInterrupts(cpu->tcBase(0)))
+        return false;
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::skipTick()
+{
+    wroteToTimeBuffer = false;
+    _nextStatus = Inactive;
+
+    for (ThreadID tid : *activeThreads) {
+        committedStores[tid] = false;
+
+        if (!rob->isEmpty(tid))
+            ppCommitStall->notify(rob->readHeadInst(tid));
+    }
+
+    numCommittedDist.sample(0);
+
+    updateStatus();
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::handleInterrupt()
@@ -742,7 +790,7 @@ DefaultCommit<Impl>::handleInterrupt()
 
     // Wait until all in flight instructions are finished before enterring
     // the interrupt.
-    if (canHandleInterrupts && cpu->instList.empty()) {
+    if (canHandleInterrupts && cpu->instList[0].empty()) {
         // Squash or record that I need to squash this cycle if
         // an interrupt needed to be handled.
         DPRINTF(Commit, "Interrupt detected.\n");
@@ -775,7 +823,7 @@ DefaultCommit<Impl>::handleInterrupt()
         DPRINTF(Commit, "Interrupt pending: instruction is %sin "
                 "flight, ROB is %sempty\n",
                 canHandleInterrupts ? "not " : "",
-                cpu->instList.empty() ? "" : "not " );
+                cpu->instList[0].empty() ? "" : "not " );
     }
 }
 
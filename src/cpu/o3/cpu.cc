@@ -45,6 +45,7 @@
  */
 
 #include "arch/kernel_stats.hh"
+#include "base/intmath.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
 #include "cpu/checker/thread_context.hh"
@@ -159,6 +160,9 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
       itb(params->itb),
       dtb(params->dtb),
       tickEvent(this),
+      numReservedInsts(params->numROBEntries +
+                       params->fetchQueueSize * params->numThreads),
+      reserveInstsEvent(this),
 #ifndef NDEBUG
       instcount(0),
 #endif
@@ -323,6 +327,17 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
     // Setup the ROB for whichever stages need it.
     commit.setROB(&rob);
 
+    // Size the window of in-flight instructions of each thread for a
+    // full ROB and fetch queue. Instructions in the other stages can
+    // take it beyond that, in which case it grows.
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid].insts.resize(
+            1 << ceilLog2(params->numROBEntries + params->fetchQueueSize));
+        instList[tid].head = instList[tid].tail = 0;
+        instList[tid].committed = 0;
+        instList[tid].squashed = 0;
+    }
+
     lastActivatedCycle = 0;
 #if 0
     // Give renameMap & rename stage access to the freeList;
@@ -546,16 +561,33 @@ FullO3CPU<Impl>::tick()
 
 //    activity = false;
 
-    //Tick each of the stages
-    fetch.tick();
+    // Tick each of the stages. A stage that is only waiting, e.g., on a
+    // cache miss or a full ROB, merely counts the cycle, so skip the
+    // rest of its tick in that case
+    if (fetch.canSkipTick())
+        fetch.skipTick();
+    else
+        fetch.tick();
 
-    decode.tick();
+    if (decode.canSkipTick())
+        decode.skipTick();
+    else
+        decode.tick();
 
-    rename.tick();
+    if (rename.canSkipTick())
+        rename.skipTick();
+    else
+        rename.tick();
 
-    iew.tick();
+    if (iew.canSkipTick())
+        iew.skipTick();
+    else
+        iew.tick();
 
-    commit.tick();
+    if (commit.canSkipTick())
+        commit.skipTick();
+    else
+        commit.tick();
 
     // Now advance the time buffers
     timeBuffer.advance();
@@ -633,6 +665,17 @@ FullO3CPU<Impl>::startup()
     iew.startupStage();
     rename.startupStage();
     commit.startupStage();
+
+    // dynamic instructions come from a free list, so fill it with
+    // enough of them to cover a full ROB and fetch queue up front
+    schedule(reserveInstsEvent, curTick());
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::reserveInsts()
+{
+    Impl::DynInst::reserve(numReservedInsts);
 }
 
 template <class Impl>
@@ -1081,9 +1124,11 @@ FullO3CPU<Impl>::isDrained() const
 {
     bool drained(true);
 
-    if (!instList.empty() || !removeList.empty()) {
-        DPRINTF(Drain, "Main CPU structures not drained.\n");
-        drained = false;
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        if (!instList[tid].empty()) {
+            DPRINTF(Drain, "Main CPU structures not drained.\n");
+            drained = false;
+        }
     }
 
     if (!fetch.isDrained()) {
@@ -1415,12 +1460,28 @@ FullO3CPU<Impl>::squashFromTC(ThreadID tid)
 }
 
 template <class Impl>
-typename FullO3CPU<Impl>::ListIt
+typename FullO3CPU<Impl>::InstPos
 FullO3CPU<Impl>::addInst(DynInstPtr &inst)
 {
-    instList.push_back(inst);
+    InstWindow &window = instList[inst->threadNumber];
+
+    // Fetch normally does not add instructions to a thread after it
+    // squashed some in the same cycle, but if it does, the squashed
+    // ones have to go first to keep the window contiguous.
+    while (window.tail != window.squashed)
+        window.at(--window.tail) = NULL;
+
+    if (window.tail - window.head == window.insts.size()) {
+        std::vector<DynInstPtr> insts(window.insts.size() * 2);
+        for (InstPos pos = window.head; pos != window.tail; pos++)
+            insts[pos & (insts.size() - 1)] = window.at(pos);
+        window.insts.swap(insts);
+    }
+
+    window.at(window.tail) = inst;
+    window.squashed = ++window.tail;
 
-    return --(instList.end());
+    return window.tail - 1;
 }
 
 template <class Impl>
@@ -1456,7 +1517,9 @@ FullO3CPU<Impl>::removeFrontInst(DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    InstWindow &window = instList[inst->threadNumber];
+    assert(inst->getInstListPos() == window.head + window.committed);
+    window.committed++;
 }
 
 template <class Impl>
@@ -1466,41 +1529,16 @@ FullO3CPU<Impl>::removeInstsNotInROB(ThreadID tid)
     DPRINTF(O3CPU, "Thread %i: Deleting instructions from instruction"
             " list.\n", tid);
 
-    ListIt end_it;
+    InstWindow &window = instList[tid];
 
-    bool rob_empty = false;
-
-    if (instList.empty()) {
+    if (window.empty()) {
         return;
     } else if (rob.isEmpty(tid)) {
         DPRINTF(O3CPU, "ROB is empty, squashing all insts.\n");
-        end_it = instList.begin();
-        rob_empty = true;
+        squashInstsFrom(window.head, tid);
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
-    }
-
-    removeInstsThisCycle = true;
-
-    ListIt inst_it = instList.end();
-
-    inst_it--;
-
-    // Walk through the instruction list, removing any instructions
-    // that were inserted after the given instruction iterator, end_it.
-    while (inst_it != end_it) {
-        assert(!instList.empty());
-
-        squashInstIt(inst_it, tid);
-
-        inst_it--;
-    }
-
-    // If the ROB was empty, then we actually need to remove the first
-    // instruction as well.
-    if (rob_empty) {
-        squashInstIt(inst_it, tid);
+        squashInstsFrom(rob.readTailInst(tid)->getInstListPos() + 1, tid);
     }
 }
 
@@ -1508,49 +1546,44 @@ template <class Impl>
 void
 FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 {
-    assert(!instList.empty());
-
-    removeInstsThisCycle = true;
+    InstWindow &window = instList[tid];
 
-    ListIt inst_iter = instList.end();
-
-    inst_iter--;
+    // The instructions of a thread are in sequence number order, so
+    // the ones to squash are those from the tail back to the first
+    // one that is not younger than seq_num.
+    InstPos pos = window.squashed;
+    while (pos != window.head + window.committed &&
+           window.at(pos - 1)->seqNum > seq_num)
+        pos--;
 
     DPRINTF(O3CPU, "Deleting instructions from instruction "
-            "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
-            tid, seq_num, (*inst_iter)->seqNum);
+            "list that are from [tid:%i] and above [sn:%lli] (%i insts).\n",
+            tid, seq_num, window.squashed - pos);
 
-    while ((*inst_iter)->seqNum > seq_num) {
+    squashInstsFrom(pos, tid);
+}
 
-        bool break_loop = (inst_iter == instList.begin());
+template <class Impl>
+void
+FullO3CPU<Impl>::squashInstsFrom(InstPos pos, ThreadID tid)
+{
+    InstWindow &window = instList[tid];
 
-        squashInstIt(inst_iter, tid);
+    removeInstsThisCycle = true;
 
-        inst_iter--;
+    // Instructions committed this cycle stay committed, and the ones
+    // already squashed this cycle are not squashed again.
+    pos = std::max(pos, window.head + window.committed);
 
-        if (break_loop)
-            break;
-    }
-}
+    while (window.squashed > pos) {
+        DynInstPtr &inst = window.at(--window.squashed);
 
-template <class Impl>
-inline void
-FullO3CPU<Impl>::squashInstIt(const ListIt &instIt, ThreadID tid)
-{
-    if ((*instIt)->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*instIt)->threadNumber,
-                (*instIt)->seqNum,
-                (*instIt)->pcState());
+                inst->threadNumber, inst->seqNum, inst->pcState());
 
         // Mark it as squashed.
-        (*instIt)->setSquashed();
-
-        // @todo: Formulate a consistent method for deleting
-        // instructions from the instruction list
-        // Remove the instruction from the list.
-        removeList.push(instIt);
+        inst->setSquashed();
     }
 }
 
@@ -1558,16 +1591,24 @@ template <class Impl>
 void
 FullO3CPU<Impl>::cleanUpRemovedInsts()
 {
-    while (!removeList.empty()) {
-        DPRINTF(O3CPU, "Removing instruction, "
-                "[tid:%i] [sn:%lli] PC %s\n",
-                (*removeList.front())->threadNumber,
-                (*removeList.front())->seqNum,
-                (*removeList.front())->pcState());
-
-        instList.erase(removeList.front());
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        InstWindow &window = instList[tid];
+
+        for (; window.committed; window.committed--) {
+            DynInstPtr &inst = window.at(window.head++);
+            DPRINTF(O3CPU, "Removing instruction, "
+                    "[tid:%i] [sn:%lli] PC %s\n",
+                    inst->threadNumber, inst->seqNum, inst->pcState());
+            inst = NULL;
+        }
 
-        removeList.pop();
+        while (window.tail != window.squashed) {
+            DynInstPtr &inst = window.at(--window.tail);
+            DPRINTF(O3CPU, "Removing instruction, "
+                    "[tid:%i] [sn:%lli] PC %s\n",
+                    inst->threadNumber, inst->seqNum, inst->pcState());
+            inst = NULL;
+        }
     }
 
     removeInstsThisCycle = false;
@@ -1586,18 +1627,18 @@ FullO3CPU<Impl>::dumpInsts()
 {
     int num = 0;
 
-    ListIt inst_list_it = instList.begin();
-
     cprintf("Dumping Instruction List\n");
 
-    while (inst_list_it != instList.end()) {
-        cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
-                "Squashed:%i\n\n",
-                num, (*inst_list_it)->instAddr(), (*inst_list_it)->threadNumber,
-                (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
-                (*inst_list_it)->isSquashed());
-        inst_list_it++;
-        ++num;
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        InstWindow &window = instList[tid];
+        for (InstPos pos = window.head; pos != window.tail; pos++) {
+            DynInstPtr &inst = window.at(pos);
+            cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\n"
+                    "Issued:%i\nSquashed:%i\n\n",
+                    num, inst->instAddr(), inst->threadNumber,
+                    inst->seqNum, inst->isIssued(), inst->isSquashed());
+            ++num;
+        }
     }
 }
 /*
@@ -106,7 +106,10 @@ class FullO3CPU : public BaseO3CPU
     typedef O3ThreadState<Impl> ImplState;
     typedef O3ThreadState<Impl> Thread;
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    /** Position of an instruction in the window of in-flight
+     *  instructions of its thread.
+     */
+    typedef uint64_t InstPos;
 
     friend class O3ThreadContext<Impl>;
 
@@ -231,6 +234,20 @@ class FullO3CPU : public BaseO3CPU
             tickEvent.squash();
     }
 
+    /** Number of dynamic instructions to keep on the free list. */
+    const unsigned numReservedInsts;
+
+    /**
+     * Fill the dynamic instruction free list. The free lists are per
+     * thread, so this has to happen on the thread that ticks the CPU
+     * and thus allocates the instructions.
+     */
+    void reserveInsts();
+
+    /** Event to reserve the instructions from the CPU's event queue. */
+    EventWrapper<FullO3CPU<Impl>, &FullO3CPU<Impl>::reserveInsts>
+        reserveInstsEvent;
+
     /**
      * Check if the pipeline has drained and signal drain done.
      *
@@ -473,7 +490,7 @@ class FullO3CPU : public BaseO3CPU
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
      */
-    ListIt addInst(DynInstPtr &inst);
+    InstPos addInst(DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, DynInstPtr &inst);
@@ -490,8 +507,10 @@ class FullO3CPU : public BaseO3CPU
     /** Remove all instructions younger than the given sequence number. */
     void removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid);
 
-    /** Removes the instruction pointed to by the iterator. */
-    inline void squashInstIt(const ListIt &instIt, ThreadID tid);
+    /** Squashes the instructions of a thread from the given position
+     *  on. They are removed at the end of the cycle.
+     */
+    void squashInstsFrom(InstPos pos, ThreadID tid);
 
     /** Cleans up all instructions on the remove list. */
     void cleanUpRemovedInsts();
@@ -505,13 +524,35 @@ class FullO3CPU : public BaseO3CPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
-
-    /** List of all the instructions that will be removed at the end of this
-     *  cycle.
+    /** All the instructions of a thread in flight, oldest first, in a
+     *  circular buffer indexed by position. Committed instructions leave
+     *  from the head and squashed ones from the tail, but only at the
+     *  end of the cycle, so the window also tracks the range of
+     *  instructions to remove.
      */
-    std::queue<ListIt> removeList;
+    struct InstWindow
+    {
+        /** Circular buffer, its size is a power of two. */
+        std::vector<DynInstPtr> insts;
+        /** Position of the oldest instruction. */
+        InstPos head;
+        /** Position after the youngest instruction. */
+        InstPos tail;
+        /** Number of instructions from the head committed this cycle. */
+        InstPos committed;
+        /** Position of the oldest instruction squashed this cycle, or the
+         *  tail if there is none.
+         */
+        InstPos squashed;
+
+        DynInstPtr &at(InstPos pos)
+        { return insts[pos & (insts.size() - 1)]; }
+
+        bool empty() const { return head == tail; }
+    };
+
+    /** Window of the instructions in flight of every thread. */
+    InstWindow instList[Impl::MaxThreads];
 
 #ifdef DEBUG
     /** Debug structure to keep track of the sequence numbers still in
@@ -136,6 +136,18 @@ class DefaultDecode
      */
     void tick();
 
+    /** Checks if all decode would do this cycle is to count an idle
+     * or blocked cycle for each thread, i.e., it has no instructions
+     * to work on, gets no signals and does not change status. If so,
+     * skipTick() can be called instead of tick().
+     */
+    bool canSkipTick() const;
+
+    /** Updates the stats exactly as tick() would when canSkipTick()
+     * holds.
+     */
+    void skipTick();
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
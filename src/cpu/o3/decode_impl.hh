@@ -581,6 +581,45 @@ DefaultDecode<Impl>::tick()
     }
 }
 
+template<class Impl>
+bool
+DefaultDecode<Impl>::canSkipTick() const
+{
+    if (fromFetch->size > 0)
+        return false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (!insts[tid].empty() ||
+            fromCommit->commitInfo[tid].squash ||
+            fromRename->renameBlock[tid] || fromRename->renameUnblock[tid])
+            return false;
+
+        // a blocked thread stays blocked as long as rename stalls it,
+        // and a running one keeps running unless rename stalls it
+        if (decodeStatus[tid] == Blocked) {
+            if (!stalls[tid].rename)
+                return false;
+        } else if ((decodeStatus[tid] != Running &&
+                    decodeStatus[tid] != Idle) || stalls[tid].rename) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class Impl>
+void
+DefaultDecode<Impl>::skipTick()
+{
+    for (ThreadID tid : *activeThreads) {
+        if (decodeStatus[tid] == Blocked)
+            ++decodeBlockedCycles;
+        else
+            ++decodeIdleCycles;
+    }
+}
+
 template<class Impl>
 void
 DefaultDecode<Impl>::decode(bool &status_change, ThreadID tid)
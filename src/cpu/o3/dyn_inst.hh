@@ -47,6 +47,7 @@
 #include <array>
 
 #include "arch/isa_traits.hh"
+#include "base/pool_alloc.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/isa_specific.hh"
@@ -57,7 +58,8 @@
 class Packet;
 
 template <class Impl>
-class BaseO3DynInst : public BaseDynInst<Impl>
+class BaseO3DynInst : public BaseDynInst<Impl>,
+                      public PoolAllocated<BaseO3DynInst<Impl> >
 {
   public:
     /** Typedef for the CPU. */
@@ -336,6 +336,18 @@ class DefaultFetch
      */
     void tick();
 
+    /** Checks if fetch would do no more this cycle than count a stall
+     * cycle and train the branch predictor on committed instructions,
+     * i.e., every thread is waiting on the I-cache, the ITLB, a trap
+     * or a quiesce, gets no squash or stall signals and has nothing
+     * to send to decode. If so, skipTick() can be called instead of
+     * tick().
+     */
+    bool canSkipTick() const;
+
+    /** Does what tick() would when canSkipTick() holds. */
+    void skipTick();
+
     /** Checks all input signals and updates the status as necessary.
      *  @return: Returns if the status has changed due to input signals.
      */
@@ -978,6 +978,60 @@ DefaultFetch<Impl>::tick()
     numInst = 0;
 }
 
+template <class Impl>
+bool
+DefaultFetch<Impl>::canSkipTick() const
+{
+    if (FullSystem && (fromCommit->commitInfo[0].interruptPending ||
+                       fromCommit->commitInfo[0].clearInterrupt))
+        return false;
+
+    // Check all threads rather than only the active ones, as the round
+    // robin fetch policy looks at all of them
+    for (ThreadID tid = 0; tid < numThreads; ++tid) {
+        if (fetchStatus[tid] != IcacheWaitResponse &&
+            fetchStatus[tid] != IcacheWaitRetry &&
+            fetchStatus[tid] != ItlbWait &&
+            fetchStatus[tid] != TrapPending &&
+            fetchStatus[tid] != QuiescePending &&
+            fetchStatus[tid] != NoGoodAddr)
+            return false;
+    }
+
+    for (ThreadID tid : *activeThreads) {
+        if (fromDecode->decodeBlock[tid] || fromDecode->decodeUnblock[tid] ||
+            fromDecode->decodeInfo[tid].squash ||
+            fromCommit->commitInfo[tid].squash || stalls[tid].drain)
+            return false;
+
+        if (!stalls[tid].decode && !fetchQueue[tid].empty())
+            return false;
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultFetch<Impl>::skipTick()
+{
+    wroteToTimeBuffer = false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (fromCommit->commitInfo[tid].doneSeqNum)
+            branchPred->update(fromCommit->commitInfo[tid].doneSeqNum, tid);
+    }
+
+    // No thread can be picked, so fetch() would only profile the stall
+    if (numFetchingThreads && numThreads == 1)
+        profileStall(0);
+
+    fetchNisnDist.sample(0);
+
+    // Keep the random number stream in step with tick()
+    random_mt.random<uint8_t>(0, activeThreads->size() - 1);
+}
+
 template <class Impl>
 bool
 DefaultFetch<Impl>::checkSignalsAndUpdate(ThreadID tid)
@@ -1120,7 +1174,7 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    instruction->setInstListPos(cpu->addInst(instruction));
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
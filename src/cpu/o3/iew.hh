@@ -289,6 +289,18 @@ class DefaultIEW
      */
     void tick();
 
+    /** Checks if all IEW would do this cycle is to count a blocked cycle
+     * and keep its internal state ticking, i.e., it has no instructions
+     * to dispatch, execute or write back, nothing for the IQ to
+     * schedule, no stores to write back, gets no squash or commit
+     * information and does not change status. If so, skipTick() can be
+     * called instead of tick().
+     */
+    bool canSkipTick();
+
+    /** Does what tick() would when canSkipTick() holds. */
+    void skipTick();
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(DynInstPtr &inst);
@@ -1568,6 +1568,66 @@ DefaultIEW<Impl>::tick()
     }
 }
 
+template <class Impl>
+bool
+DefaultIEW<Impl>::canSkipTick()
+{
+    if (exeStatus != Idle || updateLSQNextCycle ||
+        fromRename->size > 0 || fromIssue->size > 0 || toCommit->insts[0] ||
+        !instQueue.canSkipSchedule())
+        return false;
+
+    for (ThreadID tid : *activeThreads) {
+        const auto &commit_info = fromCommit->commitInfo[tid];
+
+        if (!insts[tid].empty() || commit_info.squash ||
+            commit_info.robSquashing || commit_info.doneSeqNum != 0 ||
+            commit_info.nonSpecSeqNum != 0)
+            return false;
+
+        if (ldstQueue.hasStoresToWB(tid) || ldstQueue.hasPendingStore(tid))
+            return false;
+
+        // a blocked thread stays blocked as long as the IQ is full, and
+        // a running one keeps running unless the IQ fills up
+        if (dispatchStatus[tid] == Blocked) {
+            if (!instQueue.isFull(tid))
+                return false;
+        } else if ((dispatchStatus[tid] != Running &&
+                    dispatchStatus[tid] != Idle) || instQueue.isFull(tid)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultIEW<Impl>::skipTick()
+{
+    wbNumInst = 0;
+    wbCycle = 0;
+
+    wroteToTimeBuffer = false;
+    updatedQueues = false;
+
+    fuPool->processFreeUnits();
+
+    for (ThreadID tid : *activeThreads) {
+        if (dispatchStatus[tid] == Blocked)
+            ++iewBlockCycles;
+
+        fetchRedirect[tid] = false;
+    }
+
+    instQueue.skipSchedule();
+
+    issueToExecQueue.advance();
+
+    updateStatus();
+}
+
 template <class Impl>
 void
 DefaultIEW<Impl>::updateExeInstStats(DynInstPtr &inst)
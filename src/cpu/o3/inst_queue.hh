@@ -44,6 +44,7 @@
 #ifndef __CPU_O3_INST_QUEUE_HH__
 #define __CPU_O3_INST_QUEUE_HH__
 
+#include <deque>
 #include <list>
 #include <map>
 #include <queue>
@@ -51,6 +52,7 @@
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/o3/age_matrix.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
@@ -94,6 +96,9 @@ class InstructionQueue
     // Typedef of iterator through the list of instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
+    // Typedef of iterator through the queues of instructions.
+    typedef typename std::deque<DynInstPtr>::iterator InstIt;
+
     /** FU completion event class. */
     class FUCompletion : public Event {
       private:
@@ -217,6 +222,17 @@ class InstructionQueue
      */
     void scheduleReadyInsts();
 
+    /** Checks if scheduleReadyInsts() would find nothing to schedule,
+     * i.e., there are no ready, deferred or blocked instructions. If so,
+     * skipSchedule() can be called instead.
+     */
+    bool canSkipSchedule();
+
+    /** Updates the stats exactly as scheduleReadyInsts() would when
+     * canSkipSchedule() holds.
+     */
+    void skipSchedule() { numIssuedDist.sample(0); }
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -311,11 +327,14 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** All the instructions in the IQ (some of which may be issued), in
+     *  program order. Instructions only ever leave at the head when they
+     *  commit, or as a range at the tail when they are squashed.
+     */
+    std::deque<DynInstPtr> instList[Impl::MaxThreads];
 
-    /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    /** Instructions that are ready to be executed. */
+    std::deque<DynInstPtr> instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
@@ -397,6 +416,31 @@ class InstructionQueue
      */
     void moveToYoungerInst(ListOrderIt age_order_it);
 
+    /** Whether ready instructions are kept in the age matrix rather
+     *  than in the ready lists and age order list.
+     */
+    bool useAgeMatrix;
+
+    /** Ready instructions and their age order, if useAgeMatrix is
+     *  set. Select then produces the same issue decisions as with the
+     *  ready lists.
+     */
+    AgeMatrix<DynInstPtr> ageMatrix;
+
+    /** Add an instruction that is ready to issue to the ready list
+     *  of its op class, or to the age matrix.
+     */
+    void pushReadyInst(DynInstPtr &inst);
+
+    /**
+     * Try to get a FU for an instruction, and issue it if there is
+     * one. The caller is responsible for removing the instruction
+     * from the ready instructions.
+     *
+     * @return Whether the instruction was issued.
+     */
+    bool tryIssue(DynInstPtr &issuing_inst, OpClass op_class);
+
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
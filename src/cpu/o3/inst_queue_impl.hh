@@ -114,6 +114,20 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
         memDepUnit[tid].setIQ(this);
     }
 
+    std::string scheduler = params->iqScheduler;
+    std::transform(scheduler.begin(), scheduler.end(), scheduler.begin(),
+                   (int(*)(int)) tolower);
+
+    if (scheduler == "list") {
+        useAgeMatrix = false;
+    } else if (scheduler == "agematrix") {
+        useAgeMatrix = true;
+        ageMatrix.init(numEntries);
+    } else {
+        fatal("Invalid IQ scheduler %s, options are: List, AgeMatrix\n",
+              params->iqScheduler);
+    }
+
     resetState();
 
     std::string policy = params->smtIQPolicy;
@@ -412,6 +426,8 @@ InstructionQueue<Impl>::resetState()
     }
     nonSpecInsts.clear();
     listOrder.clear();
+    if (useAgeMatrix)
+        ageMatrix.reset();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -547,7 +563,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || (useAgeMatrix && !ageMatrix.empty())) {
         return true;
     }
 
@@ -739,6 +755,85 @@ InstructionQueue<Impl>::processFUCompletion(DynInstPtr &inst, int fu_idx)
     instsToExecute.push_back(inst);
 }
 
+template <class Impl>
+bool
+InstructionQueue<Impl>::tryIssue(DynInstPtr &issuing_inst, OpClass op_class)
+{
+    IssueStruct *i2e_info = issueToExecuteQueue->access(0);
+
+    int idx = -2;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        issuing_inst->isFloating() ? fpAluAccesses++ : intAluAccesses++;
+        if (idx > -1) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == -2 || idx != -1) {
+        if (op_latency == Cycles(1)) {
+            i2e_info->size++;
+            instsToExecute.push_back(issuing_inst);
+
+            // Add the FU onto the list of FU's to be freed next
+            // cycle if we used one.
+            if (idx >= 0)
+                fuPool->freeUnitNextCycle(idx);
+        } else {
+            bool pipelined = fuPool->isPipelined(op_class);
+            // Generate completion event for the FU
+            ++wbOutstanding;
+            FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                       idx, this);
+
+            cpu->schedule(execution,
+                          cpu->clockEdge(Cycles(op_latency - 1)));
+
+            if (!pipelined) {
+                // If FU isn't pipelined, then it must be freed
+                // upon the execution completing.
+                execution->setFreeFU();
+            } else {
+                // Add the FU onto the list of FU's to be freed next cycle.
+                fuPool->freeUnitNextCycle(idx);
+            }
+        }
+
+        DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+                "[sn:%lli]\n",
+                tid, issuing_inst->pcState(),
+                issuing_inst->seqNum);
+
+        issuing_inst->setIssued();
+
+#if TRACING_ON
+        issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+        if (!issuing_inst->isMemRef()) {
+            // Memory instructions can not be freed from the IQ until they
+            // complete.
+            ++freeEntries;
+            count[tid]--;
+            issuing_inst->clearInIQ();
+        } else {
+            memDepUnit[tid].issue(issuing_inst);
+        }
+
+        statIssuedInstType[tid][op_class]++;
+        return true;
+    } else {
+        statFuBusy[op_class]++;
+        fuBusy[tid]++;
+        return false;
+    }
+}
+
 // @todo: Figure out a better way to remove the squashed items from the
 // lists.  Checking the top item of each list to see if it's squashed
 // wastes time and forces jumps.
@@ -749,8 +844,6 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     DPRINTF(IQ, "Attempting to schedule ready instructions from "
             "the IQ.\n");
 
-    IssueStruct *i2e_info = issueToExecuteQueue->access(0);
-
     DynInstPtr mem_inst;
     while (mem_inst = getDeferredMemInstToExecute()) {
         addReadyMemInst(mem_inst);
@@ -770,6 +863,37 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
+
+    if (useAgeMatrix) {
+        // Repeatedly pick the oldest ready instruction of any op class
+        // that has not failed to get a FU this cycle, which is what the
+        // walk of the age order list below amounts to.
+        ageMatrix.startSelect();
+
+        int slot;
+        while (total_issued < totalWidth &&
+               (slot = ageMatrix.selectOldest()) != -1) {
+            DynInstPtr issuing_inst = ageMatrix.inst(slot);
+            OpClass op_class = ageMatrix.opClass(slot);
+
+            issuing_inst->isFloating() ? fpInstQueueReads++ :
+                intInstQueueReads++;
+
+            if (issuing_inst->isSquashed()) {
+                ageMatrix.remove(slot);
+                ++iqSquashedInstsIssued;
+                continue;
+            }
+
+            if (tryIssue(issuing_inst, op_class)) {
+                ageMatrix.remove(slot);
+                ++total_issued;
+            } else {
+                ageMatrix.block(op_class);
+            }
+        }
+    }
+
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
 
@@ -801,54 +925,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             continue;
         }
 
-        int idx = -2;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            issuing_inst->isFloating() ? fpAluAccesses++ : intAluAccesses++;
-            if (idx > -1) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx == -2 || idx != -1) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%lli]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (tryIssue(issuing_inst, op_class)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -858,28 +935,10 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            statIssuedInstType[tid][op_class]++;
         } else {
-            statFuBusy[op_class]++;
-            fuBusy[tid]++;
             ++order_it;
         }
     }
@@ -898,6 +957,14 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     }
 }
 
+template <class Impl>
+bool
+InstructionQueue<Impl>::canSkipSchedule()
+{
+    return !hasReadyInsts() && retryMemInsts.empty() &&
+        deferredMemInsts.empty();
+}
+
 template <class Impl>
 void
 InstructionQueue<Impl>::scheduleNonSpec(const InstSeqNum &inst)
@@ -933,11 +1000,8 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i]: Committing instructions older than [sn:%i]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1032,17 +1096,7 @@ InstructionQueue<Impl>::addReadyMemInst(DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    pushReadyInst(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%lli].\n",
@@ -1174,16 +1228,19 @@ void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
     // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    InstIt squash_it = instList[tid].end();
 
     DPRINTF(IQ, "[tid:%i]: Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, which are all at the tail as the instructions are in
+    // program order, and then remove them in one go.
+    while (squash_it != instList[tid].begin() &&
+           (*(squash_it - 1))->seqNum > squashedSeqNum[tid]) {
+
+        --squash_it;
+        ++iqSquashedInstsExamined;
 
         DynInstPtr squashed_inst = (*squash_it);
         squashed_inst->isFloating() ? fpInstQueueWrites++ : intInstQueueWrites++;
@@ -1192,7 +1249,6 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
             continue;
         }
 
@@ -1279,10 +1335,9 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
 
             ++freeEntries;
         }
-
-        instList[tid].erase(squash_it--);
-        ++iqSquashedInstsExamined;
     }
+
+    instList[tid].erase(squash_it, instList[tid].end());
 }
 
 template <class Impl>
@@ -1393,17 +1448,31 @@ InstructionQueue<Impl>::addIfReady(DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%lli].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+        pushReadyInst(inst);
+    }
+}
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+template <class Impl>
+void
+InstructionQueue<Impl>::pushReadyInst(DynInstPtr &inst)
+{
+    OpClass op_class = inst->opClass();
+
+    if (useAgeMatrix) {
+        ageMatrix.insert(inst, op_class);
+        return;
+    }
+
+    readyInsts[op_class].push(inst);
+
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
     }
 }
 
@@ -1419,7 +1488,7 @@ InstructionQueue<Impl>::countInsts()
     int total_insts = 0;
 
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
-        ListIt count_it = instList[tid].begin();
+        InstIt count_it = instList[tid].begin();
 
         while (count_it != instList[tid].end()) {
             if (!(*count_it)->isSquashed() && !(*count_it)->isSquashedInIQ()) {
@@ -1448,7 +1517,8 @@ void
 InstructionQueue<Impl>::dumpLists()
 {
     for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+        cprintf("Ready list %i size: %i\n", i, useAgeMatrix ?
+                ageMatrix.size(OpClass(i)) : readyInsts[i].size());
 
         cprintf("\n");
     }
@@ -1493,7 +1563,7 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        InstIt inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -1533,7 +1603,7 @@ InstructionQueue<Impl>::dumpInsts()
 
     int num = 0;
     int valid_num = 0;
-    ListIt inst_list_it = instsToExecute.begin();
+    InstIt inst_list_it = instsToExecute.begin();
 
     while (inst_list_it != instsToExecute.end())
     {
@@ -265,6 +265,12 @@ class LSQ {
     bool willWB(ThreadID tid)
     { return thread[tid].willWB(); }
 
+    /** Returns if a specific thread has the second packet of a split
+     * store waiting to be sent.
+     */
+    bool hasPendingStore(ThreadID tid) const
+    { return thread[tid].hasPendingStore(); }
+
     /** Debugging function to print out all instructions. */
     void dumpInsts() const;
     /** Debugging function to print out instructions from a specific thread. */
@@ -225,6 +225,10 @@ class LSQUnit {
                         !storeQueue[storeWBIdx].completed &&
                         !isStoreBlocked; }
 
+    /** Returns if the second packet of a split store is waiting to be
+     * sent. */
+    bool hasPendingStore() const { return hasPendingPkt; }
+
     /** Handles doing the retry. */
     void recvRetry();
 
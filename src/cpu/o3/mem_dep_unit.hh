@@ -47,6 +47,7 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
@@ -208,8 +209,8 @@ class MemDepUnit
         /** The instruction being tracked. */
         DynInstPtr inst;
 
-        /** The iterator to the instruction's location inside the list. */
-        ListIt listIt;
+        /** The position of the instruction in the list of its thread. */
+        uint64_t listPos;
 
         /** A vector of any dependent instructions. */
         std::vector<MemDepEntryPtr> dependInsts;
@@ -237,6 +238,12 @@ class MemDepUnit
     /** Moves an entry to the ready list. */
     inline void moveToReady(MemDepEntryPtr &ready_inst_entry);
 
+    /** Adds an instruction to the list of its thread. */
+    void addToList(DynInstPtr &inst, MemDepEntryPtr &inst_entry);
+
+    /** Removes an instruction from the list of its thread. */
+    void removeFromList(ThreadID tid, uint64_t pos);
+
     typedef std::unordered_map<InstSeqNum, MemDepEntryPtr, SNHash> MemDepHash;
 
     typedef typename MemDepHash::iterator MemDepHashIt;
@@ -244,8 +251,32 @@ class MemDepUnit
     /** A hash map of all memory dependence entries. */
     MemDepHash memDepHash;
 
+    /** All instructions of a thread in the memory dependence unit,
+     *  oldest first, in a circular buffer indexed by position.
+     *  Instructions leave out of order once they complete, which only
+     *  clears their slot. The head and the tail then move past any
+     *  cleared slots, so they always hold an instruction unless the
+     *  list is empty.
+     */
+    struct InstWindow
+    {
+        /** Circular buffer, its size is a power of two. */
+        std::vector<DynInstPtr> insts;
+        /** Position of the oldest instruction. */
+        uint64_t head;
+        /** Position after the youngest instruction. */
+        uint64_t tail;
+        /** Number of slots that hold an instruction. */
+        unsigned size;
+
+        DynInstPtr &at(uint64_t pos)
+        { return insts[pos & (insts.size() - 1)]; }
+
+        bool empty() const { return size == 0; }
+    };
+
     /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    InstWindow instList[Impl::MaxThreads];
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
@@ -45,6 +45,7 @@
 
 #include <map>
 
+#include "base/intmath.hh"
 #include "cpu/o3/inst_queue.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "debug/MemDepUnit.hh"
@@ -55,6 +56,11 @@ MemDepUnit<MemDepPred, Impl>::MemDepUnit()
     : loadBarrier(false), loadBarrierSN(0), storeBarrier(false),
       storeBarrierSN(0), iqPtr(NULL)
 {
+    for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        instList[tid].insts.resize(1);
+        instList[tid].head = instList[tid].tail = 0;
+        instList[tid].size = 0;
+    }
 }
 
 template <class MemDepPred, class Impl>
@@ -66,6 +72,12 @@ MemDepUnit<MemDepPred, Impl>::MemDepUnit(DerivO3CPUParams *params)
       storeBarrierSN(0), iqPtr(NULL)
 {
     DPRINTF(MemDepUnit, "Creating MemDepUnit object.\n");
+
+    for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        instList[tid].insts.resize(1);
+        instList[tid].head = instList[tid].tail = 0;
+        instList[tid].size = 0;
+    }
 }
 
 template <class MemDepPred, class Impl>
@@ -73,18 +85,18 @@ MemDepUnit<MemDepPred, Impl>::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
-
         MemDepHashIt hash_it;
 
         while (!instList[tid].empty()) {
-            hash_it = memDepHash.find((*inst_list_it)->seqNum);
+            uint64_t pos = instList[tid].head;
+
+            hash_it = memDepHash.find(instList[tid].at(pos)->seqNum);
 
             assert(hash_it != memDepHash.end());
 
             memDepHash.erase(hash_it);
 
-            instList[tid].erase(inst_list_it++);
+            removeFromList(tid, pos);
         }
     }
 
@@ -104,6 +116,15 @@ MemDepUnit<MemDepPred, Impl>::init(DerivO3CPUParams *params, ThreadID tid)
 
     depPred.init(params->store_set_clear_period, params->SSITSize,
             params->LFSTSize);
+
+    // The list of a thread holds at most the memory instructions in the
+    // LSQ, unless completed instructions leave holes in it, in which
+    // case it grows.
+    for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        assert(instList[tid].empty());
+        instList[tid].insts.resize(
+            1 << ceilLog2(params->LQEntries + params->SQEntries));
+    }
 }
 
 template <class MemDepPred, class Impl>
@@ -184,9 +205,7 @@ MemDepUnit<MemDepPred, Impl>::insert(DynInstPtr &inst)
     MemDepEntry::memdep_insert++;
 #endif
 
-    instList[tid].push_back(inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    addToList(inst, inst_entry);
 
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
@@ -282,9 +301,7 @@ MemDepUnit<MemDepPred, Impl>::insertNonSpec(DynInstPtr &inst)
 #endif
 
     // Add the instruction to the list.
-    instList[tid].push_back(inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    addToList(inst, inst_entry);
 
     // Might want to turn this part into an inline function or something.
     // It's shared between both insert functions.
@@ -333,9 +350,7 @@ MemDepUnit<MemDepPred, Impl>::insertBarrier(DynInstPtr &barr_inst)
 #endif
 
     // Add the instruction to the instruction list.
-    instList[tid].push_back(barr_inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    addToList(barr_inst, inst_entry);
 }
 
 template <class MemDepPred, class Impl>
@@ -416,7 +431,7 @@ MemDepUnit<MemDepPred, Impl>::completed(DynInstPtr &inst)
 
     assert(hash_it != memDepHash.end());
 
-    instList[tid].erase((*hash_it).second->listIt);
+    removeFromList(tid, (*hash_it).second->listPos);
 
     (*hash_it).second = NULL;
 
@@ -497,24 +512,26 @@ MemDepUnit<MemDepPred, Impl>::squash(const InstSeqNum &squashed_num,
         }
     }
 
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    InstWindow &window = instList[tid];
 
     MemDepHashIt hash_it;
 
-    while (!instList[tid].empty() &&
-           (*squash_it)->seqNum > squashed_num) {
+    // The tail always holds an instruction, and removing it moves the
+    // tail to the next younger one that is still in the list.
+    while (!window.empty() &&
+           window.at(window.tail - 1)->seqNum > squashed_num) {
+        DynInstPtr &squash_inst = window.at(window.tail - 1);
 
         DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
-                (*squash_it)->seqNum);
+                squash_inst->seqNum);
 
-        if ((*squash_it)->seqNum == loadBarrierSN)
+        if (squash_inst->seqNum == loadBarrierSN)
               loadBarrier = false;
 
-        if ((*squash_it)->seqNum == storeBarrierSN)
+        if (squash_inst->seqNum == storeBarrierSN)
               storeBarrier = false;
 
-        hash_it = memDepHash.find((*squash_it)->seqNum);
+        hash_it = memDepHash.find(squash_inst->seqNum);
 
         assert(hash_it != memDepHash.end());
 
@@ -527,7 +544,7 @@ MemDepUnit<MemDepPred, Impl>::squash(const InstSeqNum &squashed_num,
         MemDepEntry::memdep_erase++;
 #endif
 
-        instList[tid].erase(squash_it--);
+        removeFromList(tid, window.tail - 1);
     }
 
     // Tell the dependency predictor to squash as well.
@@ -580,26 +597,66 @@ MemDepUnit<MemDepPred, Impl>::moveToReady(MemDepEntryPtr &woken_inst_entry)
 }
 
 
+template <class MemDepPred, class Impl>
+void
+MemDepUnit<MemDepPred, Impl>::addToList(DynInstPtr &inst,
+                                        MemDepEntryPtr &inst_entry)
+{
+    InstWindow &window = instList[inst->threadNumber];
+
+    if (window.tail - window.head == window.insts.size()) {
+        std::vector<DynInstPtr> insts(window.insts.size() * 2);
+        for (uint64_t pos = window.head; pos != window.tail; pos++)
+            insts[pos & (insts.size() - 1)] = window.at(pos);
+        window.insts.swap(insts);
+    }
+
+    window.at(window.tail) = inst;
+    inst_entry->listPos = window.tail++;
+    window.size++;
+}
+
+template <class MemDepPred, class Impl>
+void
+MemDepUnit<MemDepPred, Impl>::removeFromList(ThreadID tid, uint64_t pos)
+{
+    InstWindow &window = instList[tid];
+
+    assert(window.at(pos));
+    window.at(pos) = NULL;
+    window.size--;
+
+    // move the head and the tail past the cleared slots at either end
+    while (window.head != window.tail && !window.at(window.head))
+        window.head++;
+    while (window.tail != window.head && !window.at(window.tail - 1))
+        window.tail--;
+}
+
 template <class MemDepPred, class Impl>
 void
 MemDepUnit<MemDepPred, Impl>::dumpLists()
 {
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        InstWindow &window = instList[tid];
+
         cprintf("Instruction list %i size: %i\n",
-                tid, instList[tid].size());
+                tid, window.size);
 
-        ListIt inst_list_it = instList[tid].begin();
         int num = 0;
 
-        while (inst_list_it != instList[tid].end()) {
+        for (uint64_t pos = window.head; pos != window.tail; pos++) {
+            DynInstPtr &inst = window.at(pos);
+            if (!inst)
+                continue;
+
             cprintf("Instruction:%i\nPC: %s\n[sn:%i]\n[tid:%i]\nIssued:%i\n"
                     "Squashed:%i\n\n",
-                    num, (*inst_list_it)->pcState(),
-                    (*inst_list_it)->seqNum,
-                    (*inst_list_it)->threadNumber,
-                    (*inst_list_it)->isIssued(),
-                    (*inst_list_it)->isSquashed());
-            inst_list_it++;
+                    num, inst->pcState(),
+                    inst->seqNum,
+                    inst->threadNumber,
+                    inst->isIssued(),
+                    inst->isSquashed());
             ++num;
         }
     }
@@ -44,6 +44,7 @@
 #ifndef __CPU_O3_RENAME_HH__
 #define __CPU_O3_RENAME_HH__
 
+#include <deque>
 #include <list>
 
 #include "base/statistics.hh"
@@ -186,6 +187,19 @@ class DefaultRename
      */
     void tick();
 
+    /** Checks if all rename would do this cycle is to count an idle or
+     * blocked cycle for each thread and to update its history and
+     * in-flight counts from IEW and commit, i.e., it has no
+     * instructions to work on, gets no squash or stall signals, sees
+     * no change in the free entries of the back end and does not
+     * change status. If so, skipTick() can be called instead of
+     * tick().
+     */
+    bool canSkipTick();
+
+    /** Does what tick() would when canSkipTick() holds. */
+    void skipTick();
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
@@ -236,6 +250,11 @@ class DefaultRename
     /** Executes actual squash, removing squashed instructions. */
     void doSquash(const InstSeqNum &squash_seq_num, ThreadID tid);
 
+    /** Updates the rename history and the number of instructions in
+     * flight to IEW using what IEW and commit sent back.
+     */
+    void updateProgress();
+
     /** Removes a committed instruction's rename history. */
     void removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid);
 
@@ -303,10 +322,12 @@ class DefaultRename
         PhysRegIndex prevPhysReg;
     };
 
-    /** A per-thread list of all destination register renames, used to either
-     * undo rename mappings or free old physical registers.
+    /** A per-thread queue of all destination register renames, used to
+     * either undo rename mappings or free old physical registers. The
+     * youngest rename is at the front, where squashes remove entries,
+     * and commits remove them at the back.
      */
-    std::list<RenameHistory> historyBuffer[Impl::MaxThreads];
+    std::deque<RenameHistory> historyBuffer[Impl::MaxThreads];
 
     /** Pointer to CPU. */
     O3CPU *cpu;
@@ -408,11 +408,76 @@ DefaultRename<Impl>::tick()
         cpu->activityThisCycle();
     }
 
-    threads = activeThreads->begin();
+    updateProgress();
+}
 
-    while (threads != end) {
-        ThreadID tid = *threads++;
+template <class Impl>
+bool
+DefaultRename<Impl>::canSkipTick()
+{
+    if (fromDecode->size > 0)
+        return false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (!insts[tid].empty() ||
+            fromCommit->commitInfo[tid].squash ||
+            fromIEW->iewBlock[tid] || fromIEW->iewUnblock[tid])
+            return false;
+
+        // checkStall() below must see the same free entries as it
+        // would after readFreeEntries()
+        const auto &iew_info = fromIEW->iewInfo[tid];
+        const auto &commit_info = fromCommit->commitInfo[tid];
+
+        if (iew_info.usedIQ &&
+            iew_info.freeIQEntries != freeEntries[tid].iqEntries)
+            return false;
+
+        if (iew_info.usedLSQ &&
+            (iew_info.freeLQEntries != freeEntries[tid].lqEntries ||
+             iew_info.freeSQEntries != freeEntries[tid].sqEntries))
+            return false;
+
+        if (commit_info.usedROB &&
+            (commit_info.freeROBEntries != freeEntries[tid].robEntries ||
+             commit_info.emptyROB != emptyROB[tid]))
+            return false;
+
+        // a blocked thread stays blocked as long as it stalls, and a
+        // running one keeps running unless it stalls
+        if (renameStatus[tid] == Blocked) {
+            if (!checkStall(tid))
+                return false;
+        } else if ((renameStatus[tid] != Running &&
+                    renameStatus[tid] != Idle) || checkStall(tid)) {
+            return false;
+        }
+    }
 
+    return true;
+}
+
+template <class Impl>
+void
+DefaultRename<Impl>::skipTick()
+{
+    wroteToTimeBuffer = false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (renameStatus[tid] == Blocked)
+            ++renameBlockCycles;
+        else
+            ++renameIdleCycles;
+    }
+
+    updateProgress();
+}
+
+template <class Impl>
+void
+DefaultRename<Impl>::updateProgress()
+{
+    for (ThreadID tid : *activeThreads) {
         // If we committed this cycle then doneSeqNum will be > 0
         if (fromCommit->commitInfo[tid].doneSeqNum != 0 &&
             !fromCommit->commitInfo[tid].squash &&
@@ -423,7 +488,6 @@ DefaultRename<Impl>::tick()
         }
     }
 
-    // @todo: make into updateProgress function
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         instsInProgress[tid] -= fromIEW->iewInfo[tid].dispatched;
         loadsInProgress[tid] -= fromIEW->iewInfo[tid].dispatchedToLQ;
@@ -432,7 +496,6 @@ DefaultRename<Impl>::tick()
         assert(storesInProgress[tid] >= 0);
         assert(instsInProgress[tid] >=0);
     }
-
 }
 
 template<class Impl>
@@ -896,9 +959,6 @@ template <class Impl>
 void
 DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].begin();
-
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     if (historyBuffer[tid].empty()) {
@@ -908,11 +968,11 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
     // Go through the most recent instructions, undoing the mappings
     // they did and freeing up the registers.
     while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+           historyBuffer[tid].front().instSeqNum > squashed_seq_num) {
+        const RenameHistory &hb_entry = historyBuffer[tid].front();
 
         DPRINTF(Rename, "[tid:%u]: Removing history entry with sequence "
-                "number %i.\n", tid, hb_it->instSeqNum);
+                "number %i.\n", tid, hb_entry.instSeqNum);
 
         // Undo the rename mapping only if it was really a change.
         // Special regs that are not really renamed (like misc regs
@@ -920,16 +980,16 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // is the same as the old one.  While it would be merely a
         // waste of time to update the rename table, we definitely
         // don't want to put these on the free list.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
             // Tell the rename map to set the architected register to the
             // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            renameMap[tid]->setEntry(hb_entry.archReg, hb_entry.prevPhysReg);
 
             // Put the renamed physical register back on the free list.
-            freeList->addReg(hb_it->newPhysReg);
+            freeList->addReg(hb_entry.newPhysReg);
         }
 
-        historyBuffer[tid].erase(hb_it++);
+        historyBuffer[tid].pop_front();
 
         ++renameUndoneMaps;
     }
@@ -943,15 +1003,10 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%lli].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
-    typename std::list<RenameHistory>::iterator hb_it =
-        historyBuffer[tid].end();
-
-    --hb_it;
-
     if (historyBuffer[tid].empty()) {
         DPRINTF(Rename, "[tid:%u]: History buffer is empty.\n", tid);
         return;
-    } else if (hb_it->instSeqNum > inst_seq_num) {
+    } else if (historyBuffer[tid].back().instSeqNum > inst_seq_num) {
         DPRINTF(Rename, "[tid:%u]: Old sequence number encountered.  Ensure "
                 "that a syscall happened recently.\n", tid);
         return;
@@ -962,23 +1017,23 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     // rename histories if they did not have destination registers that were
     // renamed.
     while (!historyBuffer[tid].empty() &&
-           hb_it != historyBuffer[tid].end() &&
-           hb_it->instSeqNum <= inst_seq_num) {
+           historyBuffer[tid].back().instSeqNum <= inst_seq_num) {
+        const RenameHistory &hb_entry = historyBuffer[tid].back();
 
         DPRINTF(Rename, "[tid:%u]: Freeing up older rename of reg %i, "
                 "[sn:%lli].\n",
-                tid, hb_it->prevPhysReg, hb_it->instSeqNum);
+                tid, hb_entry.prevPhysReg, hb_entry.instSeqNum);
 
         // Don't free special phys regs like misc and zero regs, which
         // can be recognized because the new mapping is the same as
         // the old one.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
-            freeList->addReg(hb_it->prevPhysReg);
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
+            freeList->addReg(hb_entry.prevPhysReg);
         }
 
         ++renameCommittedMaps;
 
-        historyBuffer[tid].erase(hb_it--);
+        historyBuffer[tid].pop_back();
     }
 }
 
@@ -1406,7 +1461,7 @@ template <class Impl>
 void
 DefaultRename<Impl>::dumpHistory()
 {
-    typename std::list<RenameHistory>::iterator buf_it;
+    typename std::deque<RenameHistory>::iterator buf_it;
 
     for (ThreadID tid = 0; tid < numThreads; tid++) {
 
@@ -68,7 +68,6 @@ class ROB
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -131,7 +130,8 @@ class ROB
     DynInstPtr readHeadInst(ThreadID tid);
 
     /** Returns a pointer to the instruction with the given sequence if it is
-     *  in the ROB.
+     *  in the ROB. As the instructions of a thread are kept in program
+     *  order this is a binary search.
      */
     DynInstPtr findInst(ThreadID tid, InstSeqNum squash_inst);
 
@@ -208,12 +208,6 @@ class ROB
      */
     void squash(InstSeqNum squash_num, ThreadID tid);
 
-    /** Updates the head instruction with the new oldest instruction. */
-    void updateHead();
-
-    /** Updates the tail instruction with the new youngest instruction. */
-    void updateTail();
-
     /** Reads the PC of the oldest head instruction. */
 //    uint64_t readHeadPC();
 
@@ -262,9 +256,8 @@ class ROB
      */
     int countInsts();
 
-    /** This is more of a debugging function than anything.  Use
-     *  threadEntries to get the instructions in the ROB unless you are
-     *  double checking that variable.
+    /** Returns the number of instructions of a specific thread in
+     *  the ROB.
      */
     int countInsts(ThreadID tid);
 
@@ -290,32 +283,39 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[Impl::MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** ROB instructions of each thread, oldest first, in a circular
+     *  buffer that is large enough to hold the whole ROB. Slots that
+     *  are not in use hold a null pointer.
+     */
+    std::vector<DynInstPtr> instList[Impl::MaxThreads];
 
-    /** Number of instructions that can be squashed in a single cycle. */
-    unsigned squashWidth;
+    /** Index of the oldest instruction of each thread in instList. */
+    unsigned headIdx[Impl::MaxThreads];
 
-  public:
-    /** Iterator pointing to the instruction which is the last instruction
-     *  in the ROB.  This may at times be invalid (ie when the ROB is empty),
-     *  however it should never be incorrect.
+    /** Number of slots in a circular buffer minus one, used to wrap
+     *  indices.
      */
-    InstIt tail;
+    unsigned ringMask;
 
-    /** Iterator pointing to the instruction which is the first instruction in
-     *  in the ROB*/
-    InstIt head;
+    /** Returns the instruction at the given distance from the head of
+     *  a thread's circular buffer.
+     */
+    DynInstPtr &instAt(ThreadID tid, unsigned pos)
+    { return instList[tid][(headIdx[tid] + pos) & ringMask]; }
 
-  private:
-    /** Iterator used for walking through the list of instructions when
+    /** Number of instructions that can be squashed in a single cycle. */
+    unsigned squashWidth;
+
+    /** Index used for walking backwards through the instructions when
      *  squashing.  Used so that there is persistent state between cycles;
      *  when squashing, the instructions are marked as squashed but not
-     *  immediately removed, meaning the tail iterator remains the same before
-     *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  immediately removed.
+     *  This will always be set to invalidIdx if it is invalid.
      */
-    InstIt squashIt[Impl::MaxThreads];
+    unsigned squashIdx[Impl::MaxThreads];
+
+    /** Value of squashIdx when a thread is not squashing. */
+    static const unsigned invalidIdx = -1;
 
   public:
     /** Number of instructions in the ROB. */
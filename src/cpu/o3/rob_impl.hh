@@ -46,6 +46,7 @@
 
 #include <list>
 
+#include "base/intmath.hh"
 #include "cpu/o3/rob.hh"
 #include "debug/Fetch.hh"
 #include "debug/ROB.hh"
@@ -103,6 +104,13 @@ ROB<Impl>::ROB(O3CPU *_cpu, DerivO3CPUParams *params)
                     "Partitioned, Threshold}");
     }
 
+    // any thread may use the whole ROB, so size every circular buffer
+    // for that, rounded up to a power of two to wrap with a mask
+    unsigned ring_size = 1 << ceilLog2(numEntries);
+    ringMask = ring_size - 1;
+    for (ThreadID tid = 0; tid < numThreads; tid++)
+        instList[tid].resize(ring_size);
+
     resetState();
 }
 
@@ -113,15 +121,11 @@ ROB<Impl>::resetState()
     for (ThreadID tid = 0; tid  < numThreads; tid++) {
         doneSquashing[tid] = true;
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
+        headIdx[tid] = 0;
+        squashIdx[tid] = invalidIdx;
         squashedSeqNum[tid] = 0;
     }
     numInstsInROB = 0;
-
-    // Initialize the "universal" ROB head & tail point to invalid
-    // pointers
-    head = instList[0].end();
-    tail = instList[0].end();
 }
 
 template <class Impl>
@@ -144,7 +148,7 @@ void
 ROB<Impl>::drainSanityCheck() const
 {
     for (ThreadID tid = 0; tid  < numThreads; tid++)
-        assert(instList[tid].empty());
+        assert(isEmpty(tid));
     assert(isEmpty());
 }
 
@@ -204,7 +208,7 @@ template <class Impl>
 int
 ROB<Impl>::countInsts(ThreadID tid)
 {
-    return instList[tid].size();
+    return threadEntries[tid];
 }
 
 template <class Impl>
@@ -221,26 +225,16 @@ ROB<Impl>::insertInst(DynInstPtr &inst)
 
     ThreadID tid = inst->threadNumber;
 
-    instList[tid].push_back(inst);
-
-    //Set Up head iterator if this is the 1st instruction in the ROB
-    if (numInstsInROB == 0) {
-        head = instList[tid].begin();
-        assert((*head) == inst);
-    }
+    assert(threadEntries[tid] < numEntries);
+    assert(!instAt(tid, threadEntries[tid]));
 
-    //Must Decrement for iterator to actually be valid  since __.end()
-    //actually points to 1 after the last inst
-    tail = instList[tid].end();
-    tail--;
+    instAt(tid, threadEntries[tid]) = inst;
 
     inst->setInROB();
 
     ++numInstsInROB;
     ++threadEntries[tid];
 
-    assert((*tail) == inst);
-
     DPRINTF(ROB, "[tid:%i] Now has %d instructions.\n", tid, threadEntries[tid]);
 }
 
@@ -253,9 +247,7 @@ ROB<Impl>::retireHead(ThreadID tid)
     assert(numInstsInROB > 0);
 
     // Get the head ROB instruction.
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = (*head_it);
+    DynInstPtr head_inst = instList[tid][headIdx[tid]];
 
     assert(head_inst->readyToCommit());
 
@@ -269,14 +261,9 @@ ROB<Impl>::retireHead(ThreadID tid)
     head_inst->clearInROB();
     head_inst->setCommitted();
 
-    instList[tid].erase(head_it);
-
-    //Update "Global" Head of ROB
-    updateHead();
+    instList[tid][headIdx[tid]] = NULL;
+    headIdx[tid] = (headIdx[tid] + 1) & ringMask;
 
-    // @todo: A special case is needed if the instruction being
-    // retired is the only instruction in the ROB; otherwise the tail
-    // iterator will become invalidated.
     cpu->removeFrontInst(head_inst);
 }
 
@@ -286,7 +273,7 @@ ROB<Impl>::isHeadReady(ThreadID tid)
 {
     robReads++;
     if (threadEntries[tid] != 0) {
-        return instList[tid].front()->readyToCommit();
+        return instList[tid][headIdx[tid]]->readyToCommit();
     }
 
     return false;
@@ -333,152 +320,59 @@ ROB<Impl>::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%u]: Squashing instructions until [sn:%i].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    assert(squashIdx[tid] != invalidIdx);
 
-    if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
+    if (instList[tid][squashIdx[tid]]->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%u]: Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIdx[tid] = invalidIdx;
 
         doneSquashing[tid] = true;
         return;
     }
 
-    bool robTailUpdate = false;
-
     for (int numSquashed = 0;
          numSquashed < squashWidth &&
-         squashIt[tid] != instList[tid].end() &&
-         (*squashIt[tid])->seqNum > squashedSeqNum[tid];
+         instList[tid][squashIdx[tid]]->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
+        DynInstPtr &inst = instList[tid][squashIdx[tid]];
+
         DPRINTF(ROB, "[tid:%u]: Squashing instruction PC %s, seq num %i.\n",
-                (*squashIt[tid])->threadNumber,
-                (*squashIt[tid])->pcState(),
-                (*squashIt[tid])->seqNum);
+                inst->threadNumber, inst->pcState(), inst->seqNum);
 
         // Mark the instruction as squashed, and ready to commit so that
         // it can drain out of the pipeline.
-        (*squashIt[tid])->setSquashed();
+        inst->setSquashed();
 
-        (*squashIt[tid])->setCanCommit();
+        inst->setCanCommit();
 
 
-        if (squashIt[tid] == instList[tid].begin()) {
+        if (squashIdx[tid] == headIdx[tid]) {
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
+            squashIdx[tid] = invalidIdx;
 
             doneSquashing[tid] = true;
 
             return;
         }
 
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
-            robTailUpdate = true;
-
-        squashIt[tid]--;
+        squashIdx[tid] = (squashIdx[tid] - 1) & ringMask;
     }
 
 
     // Check if ROB is done squashing.
-    if ((*squashIt[tid])->seqNum <= squashedSeqNum[tid]) {
+    if (instList[tid][squashIdx[tid]]->seqNum <= squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%u]: Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIdx[tid] = invalidIdx;
 
         doneSquashing[tid] = true;
     }
-
-    if (robTailUpdate) {
-        updateTail();
-    }
-}
-
-
-template <class Impl>
-void
-ROB<Impl>::updateHead()
-{
-    InstSeqNum lowest_num = 0;
-    bool first_valid = true;
-
-    // @todo: set ActiveThreads through ROB or CPU
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
-
-    while (threads != end) {
-        ThreadID tid = *threads++;
-
-        if (instList[tid].empty())
-            continue;
-
-        if (first_valid) {
-            head = instList[tid].begin();
-            lowest_num = (*head)->seqNum;
-            first_valid = false;
-            continue;
-        }
-
-        InstIt head_thread = instList[tid].begin();
-
-        DynInstPtr head_inst = (*head_thread);
-
-        assert(head_inst != 0);
-
-        if (head_inst->seqNum < lowest_num) {
-            head = head_thread;
-            lowest_num = head_inst->seqNum;
-        }
-    }
-
-    if (first_valid) {
-        head = instList[0].end();
-    }
-
-}
-
-template <class Impl>
-void
-ROB<Impl>::updateTail()
-{
-    tail = instList[0].end();
-    bool first_valid = true;
-
-    list<ThreadID>::iterator threads = activeThreads->begin();
-    list<ThreadID>::iterator end = activeThreads->end();
-
-    while (threads != end) {
-        ThreadID tid = *threads++;
-
-        if (instList[tid].empty()) {
-            continue;
-        }
-
-        // If this is the first valid then assign w/out
-        // comparison
-        if (first_valid) {
-            tail = instList[tid].end();
-            tail--;
-            first_valid = false;
-            continue;
-        }
-
-        // Assign new tail if this thread's tail is younger
-        // than our current "tail high"
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*tail_thread)->seqNum > (*tail)->seqNum) {
-            tail = tail_thread;
-        }
-    }
 }
 
 
@@ -502,14 +396,9 @@ ROB<Impl>::squash(InstSeqNum squash_num, ThreadID tid)
 
     squashedSeqNum[tid] = squash_num;
 
-    if (!instList[tid].empty()) {
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
+    squashIdx[tid] = (headIdx[tid] + threadEntries[tid] - 1) & ringMask;
 
-        squashIt[tid] = tail_thread;
-
-        doSquash(tid);
-    }
+    doSquash(tid);
 }
 
 template <class Impl>
@@ -517,11 +406,11 @@ typename Impl::DynInstPtr
 ROB<Impl>::readHeadInst(ThreadID tid)
 {
     if (threadEntries[tid] != 0) {
-        InstIt head_thread = instList[tid].begin();
+        DynInstPtr &head_inst = instList[tid][headIdx[tid]];
 
-        assert((*head_thread)->isInROB());
+        assert(head_inst->isInROB());
 
-        return *head_thread;
+        return head_inst;
     } else {
         return dummyInst;
     }
@@ -531,10 +420,9 @@ template <class Impl>
 typename Impl::DynInstPtr
 ROB<Impl>::readTailInst(ThreadID tid)
 {
-    InstIt tail_thread = instList[tid].end();
-    tail_thread--;
+    assert(threadEntries[tid] != 0);
 
-    return *tail_thread;
+    return instAt(tid, threadEntries[tid] - 1);
 }
 
 template <class Impl>
@@ -555,11 +443,21 @@ template <class Impl>
 typename Impl::DynInstPtr
 ROB<Impl>::findInst(ThreadID tid, InstSeqNum squash_inst)
 {
-    for (InstIt it = instList[tid].begin(); it != instList[tid].end(); it++) {
-        if ((*it)->seqNum == squash_inst) {
-            return *it;
-        }
+    // find the oldest instruction that is not older than the one we
+    // are looking for
+    unsigned lo = 0;
+    unsigned hi = threadEntries[tid];
+    while (lo < hi) {
+        unsigned mid = lo + (hi - lo) / 2;
+        if (instAt(tid, mid)->seqNum < squash_inst)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
+
+    if (lo != threadEntries[tid] && instAt(tid, lo)->seqNum == squash_inst)
+        return instAt(tid, lo);
+
     return NULL;
 }
 
@@ -32,6 +32,7 @@
 #ifndef __PC_EVENT_HH__
 #define __PC_EVENT_HH__
 
+#include <algorithm>
 #include <vector>
 
 #include "base/misc.hh"
@@ -111,6 +112,18 @@ class PCEventQueue
     range_t equal_range(Addr pc);
     range_t equal_range(PCEvent *event) { return equal_range(event->pc()); }
 
+    /** Is there any event at a PC in [start, end)? */
+    bool
+    scheduledIn(Addr start, Addr end) const
+    {
+        if (pc_map.empty())
+            return false;
+
+        const_iterator i = std::lower_bound(pc_map.begin(), pc_map.end(),
+                                            start, MapCompare());
+        return i != pc_map.end() && (*i)->pc() < end;
+    }
+
     void dump() const;
 };
 
@@ -63,6 +63,13 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
     fastmem = Param.Bool(False, "Access memory directly")
 
+    bb_cache = Param.Bool(False, "Execute straight-line code from a cache "
+                          "of decoded basic blocks")
+    bb_cache_size = Param.Unsigned(65536, "Number of cached basic blocks "
+                                   "after which the cache is flushed")
+    bb_max_insts = Param.Unsigned(64, "Maximum number of micro-ops in a "
+                                  "cached basic block")
+
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
         simpoint.interval = interval
@@ -45,6 +45,8 @@
 #include "arch/mmapped_ipr.hh"
 #include "arch/utility.hh"
 #include "base/bigint.hh"
+#include "base/cp_annotate.hh"
+#include "base/intmath.hh"
 #include "base/output.hh"
 #include "config/the_isa.hh"
 #include "cpu/simple/atomic.hh"
@@ -99,9 +101,20 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       fastmem(p->fastmem), dcache_access(false), dcache_latency(0),
-      ppCommit(nullptr)
+      ppCommit(nullptr),
+      bbCache(p->bb_cache ?
+              new BasicBlockCache(p->bb_cache_size, p->bb_max_insts) :
+              nullptr),
+      fetchLow(MaxAddr), fetchHigh(0), bbNextPC(0), bbDropped(false),
+      bbHostGeneration(0)
 {
     _status = Idle;
+
+    fatal_if(bbCache && numThreads > 1,
+             "%s: The basic block cache does not support multiple "
+             "threads\n", name());
+    fatal_if(bbCache && p->bb_max_insts == 0,
+             "%s: Basic blocks need at least one instruction\n", name());
 }
 
 
@@ -112,6 +125,33 @@ AtomicSimpleCPU::~AtomicSimpleCPU()
     }
 }
 
+void
+AtomicSimpleCPU::regStats()
+{
+    BaseSimpleCPU::regStats();
+
+    bbCacheHits
+        .name(name() + ".bbCacheHits")
+        .desc("Number of basic blocks executed from the block cache")
+        ;
+
+    bbCacheMisses
+        .name(name() + ".bbCacheMisses")
+        .desc("Number of basic blocks recorded in the block cache")
+        ;
+
+    bbCacheOps
+        .name(name() + ".bbCacheOps")
+        .desc("Number of ops (including micro ops) executed from the "
+              "block cache")
+        ;
+
+    bbCacheInvalidations
+        .name(name() + ".bbCacheInvalidations")
+        .desc("Number of writes that dropped cached basic blocks")
+        ;
+}
+
 DrainState
 AtomicSimpleCPU::drain()
 {
@@ -159,6 +199,10 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back while drained
+    if (bbCache)
+        bbCache->flush();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -204,6 +248,9 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isDrained());
+
+    if (bbCache)
+        bbCache->flush();
 }
 
 
@@ -487,6 +534,13 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+
+                    // Drop any cached basic block the write overwrites
+                    if (bbCache &&
+                        bbCache->invalidate(req->getPaddr(), size)) {
+                        ++bbCacheInvalidations;
+                        bbDropped = true;
+                    }
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -554,6 +608,7 @@ AtomicSimpleCPU::tick()
     SimpleThread* thread = t_info.thread;
 
     Tick latency = 0;
+    int block_ops = 0;
 
     for (int i = 0; i < width || locked; ++i) {
         numCycles++;
@@ -610,11 +665,40 @@ AtomicSimpleCPU::tick()
                     // ifetch_req is initialized to read the instruction directly
                     // into the CPU object's inst field.
                 //}
+
+                if (bbCache) {
+                    fetchLow = std::min(fetchLow, ifetch_req.getPaddr());
+                    fetchHigh = std::max(fetchHigh, ifetch_req.getPaddr() +
+                                         ifetch_req.getSize());
+                }
             }
 
             preExecute();
 
+            if (bbCache && needToFetch && curStaticInst) {
+                Tick stall_ticks = 0;
+                int ops = enterBlock(stall_ticks);
+                if (ops) {
+                    // The whole block has been executed and the PC
+                    // moved past it; account for its instructions as
+                    // if each one took an iteration of this loop.
+                    i += ops - 1;
+                    block_ops += ops - 1;
+                    numCycles += ops - 1;
+                    ppCycles->notify(ops - 1);
+                    if (stall_ticks) {
+                        latency += divCeil(stall_ticks, clockPeriod()) *
+                            clockPeriod();
+                    }
+                    continue;
+                }
+            }
+
             if (curStaticInst) {
+                TheISA::PCState inst_pc;
+                if (bbCache)
+                    inst_pc = thread->pcState();
+
                 fault = curStaticInst->execute(&t_info, traceData);
 
                 // keep an instruction count
@@ -628,6 +712,9 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                if (bbCache && bbCache->recording())
+                    recordInst(inst_pc, fault);
             }
 
             // @todo remove me after debugging with legion done
@@ -651,21 +738,269 @@ AtomicSimpleCPU::tick()
             }
 
         }
-        if(fault != NoFault || !t_info.stayAtPC)
+        if(fault != NoFault || !t_info.stayAtPC) {
             advancePC(fault);
+            fetchLow = MaxAddr;
+            fetchHigh = 0;
+        }
     }
 
     if (tryCompleteDrain())
         return;
 
-    // instruction takes at least one cycle
-    if (latency < clockPeriod())
-        latency = clockPeriod();
+    // instruction takes at least one cycle, and instructions executed
+    // from the basic block cache take their share of cycles
+    const Tick min_latency =
+        divCeil(width + block_ops, width) * clockPeriod();
+    if (latency < min_latency)
+        latency = min_latency;
 
     if (_status != Idle)
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+int
+AtomicSimpleCPU::enterBlock(Tick &stall_ticks)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    const TheISA::PCState pc = thread->pcState();
+    const Addr inst_addr = pc.instAddr();
+    const Addr fetch_low = fetchLow;
+    const Addr fetch_high = fetchHigh;
+
+    fetchLow = MaxAddr;
+    fetchHigh = 0;
+
+    // The blocks point to the backing store of the memory
+    const uint64_t host_generation =
+        system->getPhysMem().getHostGeneration();
+    if (host_generation != bbHostGeneration) {
+        bbCache->flush();
+        bbHostGeneration = host_generation;
+    }
+
+    // The physical address of the instruction is only known if the
+    // last fetch for it was in the same page as its start.
+    const Addr fetch_vaddr = ifetch_req.getVaddr();
+    const bool known_paddr = roundDown(fetch_vaddr, TheISA::PageBytes) ==
+        roundDown(inst_addr, TheISA::PageBytes);
+    const Addr paddr = ifetch_req.getPaddr() - (fetch_vaddr - inst_addr);
+
+    if (bbCache->recording()) {
+        if (known_paddr && inst_addr == bbNextPC &&
+            bbCache->recordedInsts() < bbCache->maxInsts() &&
+            bbCache->addCode(paddr, inst_addr, fetch_low, fetch_high)) {
+            return 0;
+        }
+
+        // Control left the straight-line path (e.g., an interrupt or a
+        // PC event), or the block cannot grow any further.
+        commitBlock();
+    }
+
+    if (!known_paddr)
+        return 0;
+
+    const BasicBlockCache::Block *block = bbCache->lookup(paddr);
+    if (block) {
+        const BasicBlockCache::Inst &first = block->insts.front();
+        if (first.staticInst == curStaticInst &&
+            first.macroInst == curMacroStaticInst && first.pc == pc &&
+            block->codeValid()) {
+            if (!canExecuteBlock(*block))
+                return 0;
+
+            ++bbCacheHits;
+            return executeBlock(*block, stall_ticks);
+        }
+    }
+
+    ++bbCacheMisses;
+    bbCache->begin(paddr, inst_addr);
+    if (!bbCache->addCode(paddr, inst_addr, fetch_low, fetch_high))
+        bbCache->abort();
+
+    return 0;
+}
+
+bool
+AtomicSimpleCPU::canExecuteBlock(const BasicBlockCache::Block &block)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    // Anything that needs to see every instruction
+    if (traceData || branchPred || ppCommit->hasListeners() ||
+        (FullSystem && thread->profile) || CPA::available()) {
+        return false;
+    }
+
+    // Events that would trigger in the middle of the block. Events at
+    // its first instruction have already been serviced.
+    if (system->pcEventQueue.scheduledIn(block.startPC + 1,
+                                         block.lastPC + 1)) {
+        return false;
+    }
+
+    const EventQueue *inst_queue = comInstEventQueue[curThread];
+    if (!inst_queue->empty() &&
+        inst_queue->nextTick() <= t_info.numInst + block.counts.numInsts) {
+        return false;
+    }
+
+    const EventQueue *load_queue = comLoadEventQueue[curThread];
+    if (!load_queue->empty() &&
+        load_queue->nextTick() <= t_info.numLoad + block.counts.numLoads) {
+        return false;
+    }
+
+    const EventQueue &sys_queue = system->instEventQueue;
+    if (!sys_queue.empty() &&
+        sys_queue.nextTick() <=
+        system->totalNumInsts + block.counts.numOps) {
+        return false;
+    }
+
+    return true;
+}
+
+int
+AtomicSimpleCPU::executeBlock(const BasicBlockCache::Block &block,
+                              Tick &stall_ticks)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    DPRINTF(SimpleCPU, "Executing cached block at %#x\n", block.startPC);
+
+    bbDropped = false;
+    Fault fault = NoFault;
+    auto inst = block.insts.begin();
+    for (; inst != block.insts.end(); ++inst) {
+        curStaticInst = inst->staticInst;
+        curMacroStaticInst = inst->macroInst;
+        thread->pcState(inst->pc);
+
+        // maintain $r0 semantics
+        thread->setIntReg(ZeroReg, 0);
+#if THE_ISA == ALPHA_ISA
+        thread->setFloatReg(ZeroReg, 0.0);
+#endif // ALPHA_ISA
+
+        dcache_access = false;
+        fault = curStaticInst->execute(&t_info, NULL);
+
+        if (simulate_data_stalls && dcache_access)
+            stall_ticks += dcache_latency;
+
+        if (fault != NoFault)
+            break;
+
+        advancePC(fault);
+
+        // Stop at the next macroop boundary if the block overwrote its
+        // own code or put the CPU to sleep.
+        if ((bbDropped || _status == Idle) && !curMacroStaticInst) {
+            ++inst;
+            break;
+        }
+    }
+
+    const auto done = inst;
+    if (done == block.insts.end()) {
+        countBlock(block.counts, true);
+    } else {
+        countBlock(BasicBlockCache::count(block.insts.begin(), done),
+                   true);
+        if (fault != NoFault) {
+            // The faulting instruction is not committed but is still
+            // counted in the execution statistics.
+            countBlock(BasicBlockCache::count(done, done + 1), false);
+            advancePC(fault);
+        }
+    }
+
+    const int ops = (done - block.insts.begin()) + (fault != NoFault);
+    bbCacheOps += ops;
+    return ops;
+}
+
+void
+AtomicSimpleCPU::countBlock(const BasicBlockCache::Counts &counts,
+                            bool committed)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+
+    if (committed) {
+        t_info.numInst += counts.numInsts;
+        t_info.numInsts += counts.numInsts;
+        t_info.numOp += counts.numOps;
+        t_info.numOps += counts.numOps;
+        system->totalNumInsts += counts.numOps;
+        t_info.thread->funcExeInst += counts.numOps;
+    }
+
+    t_info.numMemRefs += counts.numMemRefs;
+    t_info.numLoad += counts.numLoads;
+    t_info.numBranches += counts.numBranches;
+    t_info.numIntAluAccesses += counts.numIntInsts;
+    t_info.numIntInsts += counts.numIntInsts;
+    t_info.numFpAluAccesses += counts.numFpInsts;
+    t_info.numFpInsts += counts.numFpInsts;
+    t_info.numCallsReturns += counts.numCallsReturns;
+    t_info.numCondCtrlInsts += counts.numCondCtrlInsts;
+    t_info.numLoadInsts += counts.numLoads;
+    t_info.numStoreInsts += counts.numStores;
+    for (const auto &op_class : counts.opClasses)
+        t_info.statExecutedInstType[op_class.first] += op_class.second;
+
+    instCnt += counts.numFetched;
+
+    if (counts.numInsts)
+        ppRetiredInsts->notify(counts.numInsts);
+    if (counts.numLoads)
+        ppRetiredLoads->notify(counts.numLoads);
+    if (counts.numStores)
+        ppRetiredStores->notify(counts.numStores);
+    if (counts.numBranches)
+        ppRetiredBranches->notify(counts.numBranches);
+}
+
+void
+AtomicSimpleCPU::recordInst(const TheISA::PCState &pc, const Fault &fault)
+{
+    if (fault != NoFault || isRomMicroPC(pc.microPC())) {
+        bbCache->abort();
+        return;
+    }
+
+    const bool complete =
+        bbCache->addInst(pc, curStaticInst, curMacroStaticInst);
+    const bool ends = BasicBlockCache::endsBlock(curStaticInst);
+
+    if (!complete) {
+        // Control flow within a macroop cannot be cached
+        if (ends)
+            bbCache->abort();
+        return;
+    }
+
+    if (ends || bbCache->recordedInsts() >= bbCache->maxInsts()) {
+        commitBlock();
+    } else {
+        TheISA::PCState next_pc = pc;
+        TheISA::advancePC(next_pc, curStaticInst);
+        bbNextPC = next_pc.instAddr();
+    }
+}
+
+void
+AtomicSimpleCPU::commitBlock()
+{
+    bbCache->commit(system->getPhysMem());
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
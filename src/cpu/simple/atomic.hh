@@ -43,7 +43,10 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+
 #include "cpu/simple/base.hh"
+#include "cpu/simple/bb_cache.hh"
 #include "cpu/simple/exec_context.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -56,6 +59,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual ~AtomicSimpleCPU();
 
     void init() override;
+    void regStats() override;
 
   private:
 
@@ -178,6 +182,69 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
 
+    /**
+     * @{
+     * @name Basic block cache
+     *
+     * When enabled, straight-line code is recorded as it executes and
+     * later executed from the cache without fetching and decoding
+     * every instruction, updating the statistics once per block.
+     * Interrupts, PC events and instruction count events are only
+     * checked between blocks, and a block is never used when
+     * tracing, profiling, branch prediction or commit probe listeners
+     * need to see individual instructions.
+     */
+
+    /** Decoded basic blocks, NULL if the cache is disabled. */
+    std::unique_ptr<BasicBlockCache> bbCache;
+
+    /** Physical address range fetched for the current instruction. */
+    Addr fetchLow;
+    Addr fetchHigh;
+
+    /** PC the next instruction of the block being recorded must have. */
+    Addr bbNextPC;
+
+    /** Set when a write drops cached blocks. */
+    bool bbDropped;
+
+    /** Generation of the memory host mappings the blocks refer to. */
+    uint64_t bbHostGeneration;
+
+    /**
+     * Called once the instruction at the current PC has been fetched
+     * and decoded. Executes the cached block starting with it if
+     * possible, and otherwise continues or starts recording a block.
+     *
+     * @param stall_ticks Incremented by the data stalls of the block.
+     * @return Number of (micro-)instructions executed from the cache,
+     *         0 if the instruction has to be executed normally.
+     */
+    int enterBlock(Tick &stall_ticks);
+
+    /** Can a cached block be executed at this point? */
+    bool canExecuteBlock(const BasicBlockCache::Block &block);
+
+    /** Execute a cached block, returning the number of instructions. */
+    int executeBlock(const BasicBlockCache::Block &block,
+                     Tick &stall_ticks);
+
+    /** Apply the counts of (a part of) an executed block. */
+    void countBlock(const BasicBlockCache::Counts &counts, bool committed);
+
+    /** Add an instruction executed normally to the block being recorded. */
+    void recordInst(const TheISA::PCState &pc, const Fault &fault);
+
+    /** Add the block being recorded to the cache. */
+    void commitBlock();
+
+    Stats::Scalar bbCacheHits;
+    Stats::Scalar bbCacheMisses;
+    Stats::Scalar bbCacheOps;
+    Stats::Scalar bbCacheInvalidations;
+
+    /** @} */
+
   protected:
 
     /** Return a reference to the data port. */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/bb_cache.hh"
+
+#include <algorithm>
+
+#include "arch/isa_traits.hh"
+#include "base/intmath.hh"
+#include "debug/BasicBlockCache.hh"
+#include "mem/physical.hh"
+
+BasicBlockCache::BasicBlockCache(size_t max_blocks, size_t max_insts)
+    : maxBlocks(max_blocks), maxBlockInsts(max_insts)
+{
+}
+
+BasicBlockCache::~BasicBlockCache()
+{
+}
+
+void
+BasicBlockCache::begin(Addr paddr, Addr pc)
+{
+    building.reset(new Block);
+    building->paddr = paddr;
+    building->startPC = pc;
+    building->lastPC = pc;
+    building->complete = 0;
+    building->codeAddr = paddr;
+    building->hostCode = NULL;
+}
+
+bool
+BasicBlockCache::addCode(Addr paddr, Addr pc, Addr fetch_low,
+                         Addr fetch_high)
+{
+    Block &block = *building;
+    const Addr page = roundDown(block.paddr, TheISA::PageBytes);
+
+    // All the code of a block has to live in the page of its first
+    // instruction, since the translation is only checked for that one.
+    if (roundDown(fetch_low, TheISA::PageBytes) != page ||
+        roundDown(fetch_high - 1, TheISA::PageBytes) != page ||
+        paddr - block.paddr != pc - block.startPC) {
+        return false;
+    }
+
+    const Addr code_end = std::max(block.codeAddr + block.code.size(),
+                                   fetch_high);
+    block.codeAddr = std::min(block.codeAddr, fetch_low);
+    block.code.resize(code_end - block.codeAddr);
+    return true;
+}
+
+bool
+BasicBlockCache::addInst(const TheISA::PCState &pc,
+                         const StaticInstPtr &inst,
+                         const StaticInstPtr &macro)
+{
+    building->insts.push_back(Inst{pc, inst, macro});
+    if (inst->isMicroop() && !inst->isLastMicroop())
+        return false;
+
+    building->complete = building->insts.size();
+    return true;
+}
+
+void
+BasicBlockCache::commit(const PhysicalMemory &mem)
+{
+    std::unique_ptr<Block> block(std::move(building));
+    assert(block);
+
+    block->insts.resize(block->complete);
+    if (block->insts.empty())
+        return;
+
+    block->hostCode = mem.hostAddr(block->codeAddr, block->code.size());
+    if (!block->hostCode) {
+        DPRINTF(BasicBlockCache, "Dropping block at %#x, code not in "
+                "memory\n", block->paddr);
+        return;
+    }
+
+    std::memcpy(block->code.data(), block->hostCode, block->code.size());
+    block->lastPC = block->insts.back().pc.instAddr();
+    block->counts = count(block->insts.begin(), block->insts.end());
+
+    if (blocks.size() >= maxBlocks) {
+        DPRINTF(BasicBlockCache, "Cache full, flushing %d blocks\n",
+                blocks.size());
+        flush();
+    }
+
+    DPRINTF(BasicBlockCache, "New block at %#x (pc %#x-%#x), %d insts\n",
+            block->paddr, block->startPC, block->lastPC,
+            block->insts.size());
+
+    const Addr paddr = block->paddr;
+    auto it = blocks.find(paddr);
+    if (it != blocks.end()) {
+        retired.push_back(std::move(it->second));
+        it->second = std::move(block);
+    } else {
+        blocks.emplace(paddr, std::move(block));
+        pages[roundDown(paddr, TheISA::PageBytes)].push_back(paddr);
+    }
+}
+
+bool
+BasicBlockCache::doInvalidate(Addr paddr, unsigned size)
+{
+    bool dropped = false;
+    const Addr end = paddr + size;
+
+    if (building && overlaps(*building, paddr, end)) {
+        abort();
+        dropped = true;
+    }
+
+    // Blocks never cross a page, so only the blocks in the pages
+    // touched by the write can overlap it.
+    for (Addr page = roundDown(paddr, TheISA::PageBytes); page < end;
+         page += TheISA::PageBytes) {
+        auto it = pages.find(page);
+        if (it == pages.end())
+            continue;
+
+        std::vector<Addr> &page_blocks = it->second;
+        for (auto a = page_blocks.begin(); a != page_blocks.end(); ) {
+            auto block = blocks.find(*a);
+            assert(block != blocks.end());
+            if (!overlaps(*block->second, paddr, end)) {
+                ++a;
+                continue;
+            }
+
+            DPRINTF(BasicBlockCache, "Write to %#x, dropping block at "
+                    "%#x\n", paddr, *a);
+            retired.push_back(std::move(block->second));
+            blocks.erase(block);
+            a = page_blocks.erase(a);
+            dropped = true;
+        }
+
+        if (page_blocks.empty())
+            pages.erase(it);
+    }
+
+    return dropped;
+}
+
+void
+BasicBlockCache::flush()
+{
+    for (auto &block : blocks)
+        retired.push_back(std::move(block.second));
+    blocks.clear();
+    pages.clear();
+    building.reset();
+}
+
+BasicBlockCache::Counts
+BasicBlockCache::count(std::vector<Inst>::const_iterator begin,
+                       std::vector<Inst>::const_iterator end)
+{
+    Counts counts;
+    std::vector<Counter> op_classes(Num_OpClasses, 0);
+
+    counts.numInsts = counts.numOps = counts.numFetched = 0;
+    counts.numMemRefs = counts.numLoads = counts.numStores = 0;
+    counts.numBranches = counts.numIntInsts = counts.numFpInsts = 0;
+    counts.numCallsReturns = counts.numCondCtrlInsts = 0;
+
+    for (auto i = begin; i != end; ++i) {
+        const StaticInstPtr &inst = i->staticInst;
+
+        if (!inst->isMicroop() || inst->isLastMicroop())
+            ++counts.numInsts;
+        if (!inst->isMicroop() || inst->isFirstMicroop())
+            ++counts.numFetched;
+        ++counts.numOps;
+
+        counts.numMemRefs += inst->isMemRef();
+        counts.numLoads += inst->isLoad();
+        counts.numStores += inst->isStore();
+        counts.numBranches += inst->isControl();
+        counts.numIntInsts += inst->isInteger();
+        counts.numFpInsts += inst->isFloating();
+        counts.numCallsReturns += inst->isCall() || inst->isReturn();
+        counts.numCondCtrlInsts += inst->isCondCtrl();
+        ++op_classes[inst->opClass()];
+    }
+
+    for (int op = 0; op < Num_OpClasses; ++op) {
+        if (op_classes[op])
+            counts.opClasses.emplace_back(OpClass(op), op_classes[op]);
+    }
+
+    return counts;
+}
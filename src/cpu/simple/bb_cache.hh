@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Cache of pre-decoded basic blocks used by the atomic CPU to skip
+ * instruction fetch and decode when fast-forwarding.
+ */
+
+#ifndef __CPU_SIMPLE_BB_CACHE_HH__
+#define __CPU_SIMPLE_BB_CACHE_HH__
+
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/types.hh"
+#include "cpu/op_class.hh"
+#include "cpu/static_inst.hh"
+
+class PhysicalMemory;
+
+/**
+ * A basic block is a straight-line sequence of (micro-)instructions
+ * fetched from a single physical page. It always starts at a macroop
+ * boundary and ends with the last microop of a macroop, normally a
+ * control instruction or an instruction that may change the state
+ * decoding depends on (serializing, non-speculative, syscalls and the
+ * like). Blocks are indexed by the physical address of their first
+ * instruction.
+ *
+ * A block is only ever used after the CPU has fetched and decoded its
+ * first instruction the normal way, and after checking that the
+ * decoder produced the same StaticInst and that the code bytes in
+ * memory have not changed since the block was built. Together with the
+ * invalidation of blocks on writes to their page, this keeps the
+ * cached decode consistent with the decoder state and with the
+ * contents of memory.
+ */
+class BasicBlockCache
+{
+  public:
+    struct Inst
+    {
+        /** PC state just before the instruction executed. */
+        TheISA::PCState pc;
+        StaticInstPtr staticInst;
+        StaticInstPtr macroInst;
+    };
+
+    /**
+     * Statistics of executing a range of instructions, used to update
+     * the CPU counters once per block rather than once per
+     * instruction.
+     */
+    struct Counts
+    {
+        Counter numInsts;
+        Counter numOps;
+        Counter numFetched;
+        Counter numMemRefs;
+        Counter numLoads;
+        Counter numStores;
+        Counter numBranches;
+        Counter numIntInsts;
+        Counter numFpInsts;
+        Counter numCallsReturns;
+        Counter numCondCtrlInsts;
+        std::vector<std::pair<OpClass, Counter>> opClasses;
+    };
+
+    struct Block
+    {
+        /** Physical address of the first instruction. */
+        Addr paddr;
+
+        /** Virtual address of the first and last instructions. */
+        Addr startPC;
+        Addr lastPC;
+
+        std::vector<Inst> insts;
+
+        /** Number of instructions up to the last macroop boundary. */
+        size_t complete;
+
+        /** Physical address and copy of the fetched code bytes. */
+        Addr codeAddr;
+        std::vector<uint8_t> code;
+
+        /** Host address of the code bytes in the memory backing store. */
+        const uint8_t *hostCode;
+
+        /** Counts of a complete execution of the block. */
+        Counts counts;
+
+        /** Check that the code in memory still matches the block. */
+        bool
+        codeValid() const
+        {
+            return std::memcmp(hostCode, code.data(), code.size()) == 0;
+        }
+    };
+
+    /**
+     * @param max_blocks Number of blocks after which the cache is
+     *                   flushed.
+     * @param max_insts Maximum number of (micro-)instructions in a
+     *                  block.
+     */
+    BasicBlockCache(size_t max_blocks, size_t max_insts);
+    ~BasicBlockCache();
+
+    /** Find the block starting at a physical address, NULL if none. */
+    const Block *
+    lookup(Addr paddr)
+    {
+        retired.clear();
+        auto it = blocks.find(paddr);
+        return it == blocks.end() ? NULL : it->second.get();
+    }
+
+    /**
+     * Start recording a new block, dropping any block previously
+     * cached at the same address.
+     *
+     * @param paddr Physical address of the first instruction.
+     * @param pc Virtual address of the first instruction.
+     */
+    void begin(Addr paddr, Addr pc);
+
+    /** Is a block being recorded? */
+    bool recording() const { return building != nullptr; }
+
+    /**
+     * Add the code fetched for the next instruction of the block being
+     * recorded.
+     *
+     * @return false if the code does not fit in the page of the block,
+     *         in which case the block has to end before the
+     *         instruction.
+     */
+    bool addCode(Addr paddr, Addr pc, Addr fetch_low, Addr fetch_high);
+
+    /**
+     * Add an executed (micro-)instruction to the block.
+     *
+     * @return true if the instruction completes a macroop.
+     */
+    bool addInst(const TheISA::PCState &pc, const StaticInstPtr &inst,
+                 const StaticInstPtr &macro);
+
+    /** Number of instructions recorded so far. */
+    size_t recordedInsts() const { return building->insts.size(); }
+
+    /** Maximum number of instructions in a block. */
+    size_t maxInsts() const { return maxBlockInsts; }
+
+    /**
+     * Add the block being recorded to the cache, leaving out any
+     * incomplete macroop at its end. Blocks whose code is not in a
+     * memory backing store are dropped.
+     */
+    void commit(const PhysicalMemory &mem);
+
+    /** Give up on the block being recorded. */
+    void abort() { building.reset(); }
+
+    /**
+     * Drop all blocks whose code overlaps a write.
+     *
+     * @return true if any block, or the block being recorded, was
+     *         dropped.
+     */
+    bool
+    invalidate(Addr paddr, unsigned size)
+    {
+        if (pages.empty() && !building)
+            return false;
+        return doInvalidate(paddr, size);
+    }
+
+    /** Drop all blocks. */
+    void flush();
+
+    /** Number of blocks in the cache. */
+    size_t size() const { return blocks.size(); }
+
+    /** Does an instruction end a basic block? */
+    static bool
+    endsBlock(const StaticInstPtr &inst)
+    {
+        return inst->isControl() || inst->isSerializing() ||
+            inst->isNonSpeculative() || inst->isSyscall() ||
+            inst->isQuiesce() || inst->isIprAccess() ||
+            inst->isSquashAfter();
+    }
+
+    /** Count the statistics of a range of instructions. */
+    static Counts count(std::vector<Inst>::const_iterator begin,
+                        std::vector<Inst>::const_iterator end);
+
+  private:
+    bool doInvalidate(Addr paddr, unsigned size);
+
+    /** Does the code of a block overlap [start, end)? */
+    static bool
+    overlaps(const Block &block, Addr start, Addr end)
+    {
+        return start < block.codeAddr + block.code.size() &&
+            block.codeAddr < end;
+    }
+
+    const size_t maxBlocks;
+    const size_t maxBlockInsts;
+
+    /** Cached blocks indexed by the address of their first instruction. */
+    std::unordered_map<Addr, std::unique_ptr<Block>> blocks;
+
+    /** Addresses of the cached blocks in each physical page. */
+    std::unordered_map<Addr, std::vector<Addr>> pages;
+
+    /**
+     * Blocks dropped while they may still be executing. They are
+     * deleted on the next lookup.
+     */
+    std::vector<std::unique_ptr<Block>> retired;
+
+    /** Block being recorded, if any. */
+    std::unique_ptr<Block> building;
+};
+
+#endif // __CPU_SIMPLE_BB_CACHE_HH__
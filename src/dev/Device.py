@@ -49,6 +49,9 @@ class DmaDevice(PioDevice):
     cxx_header = "dev/io_device.hh"
     abstract = True
     dma = MasterPort("DMA port")
+    dma_batch = Param.Bool(False, "Send DMA requests as a batch when the "
+                           "memory system accepts one, which lets it "
+                           "reserve resources ahead of time")
 
 
 class IsaFake(BasicPioDevice):
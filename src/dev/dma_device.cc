@@ -52,10 +52,11 @@
 #include "debug/Drain.hh"
 #include "sim/system.hh"
 
-DmaPort::DmaPort(MemObject *dev, System *s)
+DmaPort::DmaPort(MemObject *dev, System *s, bool batch_reqs)
     : MasterPort(dev->name() + ".dma", dev),
       device(dev), sys(s), masterId(s->getMasterId(dev->name())),
-      sendEvent(this), pendingCount(0), inRetry(false)
+      batchReqs(batch_reqs), sendEvent(this), pendingCount(0),
+      inRetry(false)
 { }
 
 void
@@ -115,7 +116,7 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 }
 
 DmaDevice::DmaDevice(const Params *p)
-    : PioDevice(p), dmaPort(this, sys)
+    : PioDevice(p), dmaPort(this, sys, p->dma_batch)
 { }
 
 void
@@ -199,6 +200,11 @@ DmaPort::queueDma(PacketPtr pkt)
 void
 DmaPort::trySendTimingReq()
 {
+    if (batchReqs && peerAcceptsTimingReqBatch()) {
+        trySendTimingReqBatch();
+        return;
+    }
+
     // send the first packet on the transmit list and schedule the
     // following send if it is successful
     PacketPtr pkt = transmitList.front();
@@ -225,6 +231,47 @@ DmaPort::trySendTimingReq()
             transmitList.size(), inRetry);
 }
 
+void
+DmaPort::trySendTimingReqBatch()
+{
+    // offer the whole transmit list, and schedule the following send
+    // if at least the first packet is accepted
+    size_t batch_size = transmitList.size();
+
+    batch.clear();
+    for (size_t i = 0; i < batch_size; ++i) {
+        // this should ultimately wait for as many cycles as the
+        // device needs to send the packet, but currently the port
+        // does not have any known width so simply wait a single cycle
+        // between packets
+        Tick when = i == 0 ? curTick() : device->clockEdge(Cycles(i));
+        batch.emplace_back(transmitList[i], when);
+    }
+
+    DPRINTF(DMA, "Trying to send %s addr %#x, batch of %d\n",
+            batch.front().pkt->cmdString(), batch.front().pkt->getAddr(),
+            batch.size());
+
+    unsigned accepted = sendTimingReqBatch(batch);
+    inRetry = accepted == 0;
+    if (!inRetry) {
+        transmitList.erase(transmitList.begin(),
+                           transmitList.begin() + accepted);
+        DPRINTF(DMA, "-- Done, %d sent\n", accepted);
+        // if there is more to do, then do so when the next packet is
+        // due
+        if (!transmitList.empty())
+            device->schedule(sendEvent, accepted < batch.size() ?
+                             batch[accepted].when :
+                             device->clockEdge(Cycles(accepted)));
+    } else {
+        DPRINTF(DMA, "-- Failed, waiting for retry\n");
+    }
+
+    DPRINTF(DMA, "TransmitList: %d, inRetry: %d\n",
+            transmitList.size(), inRetry);
+}
+
 void
 DmaPort::sendDma()
 {
@@ -62,10 +62,21 @@ class DmaPort : public MasterPort, public Drainable
      * Take the first packet of the transmit list and attempt to send
      * it as a timing request. If it is successful, schedule the
      * sending of the next packet, otherwise remember that we are
-     * waiting for a retry.
+     * waiting for a retry. If batching is enabled and the peer
+     * accepts batches, the whole list is sent by
+     * trySendTimingReqBatch() instead.
      */
     void trySendTimingReq();
 
+    /**
+     * Offer the whole transmit list as a batch of timing requests,
+     * with every packet stamped with the cycle on which it would
+     * otherwise have been sent. The peer may reserve resources for
+     * the packets ahead of time, which can change the timing seen by
+     * other masters, so this is only used when enabled.
+     */
+    void trySendTimingReqBatch();
+
     /**
      * For timing, attempt to send the first item on the transmit
      * list, and if it is successful and there are more packets
@@ -118,6 +129,9 @@ class DmaPort : public MasterPort, public Drainable
     /** Id for all requests */
     const MasterID masterId;
 
+    /** Send the transmit list as a batch if the peer accepts one. */
+    const bool batchReqs;
+
   protected:
     /** Use a deque as we never do any insertion or removal in the middle */
     std::deque<PacketPtr> transmitList;
@@ -132,6 +146,9 @@ class DmaPort : public MasterPort, public Drainable
      * send whatever it is that it's sending. */
     bool inRetry;
 
+    /** Batch of timing requests, kept to reuse its storage. */
+    PacketBatch batch;
+
   protected:
 
     bool recvTimingResp(PacketPtr pkt) override;
@@ -141,7 +158,7 @@ class DmaPort : public MasterPort, public Drainable
 
   public:
 
-    DmaPort(MemObject *dev, System *s);
+    DmaPort(MemObject *dev, System *s, bool batch_reqs = false);
 
     RequestPtr dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
                          uint8_t *data, Tick delay, Request::Flags flag = 0);
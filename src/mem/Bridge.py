@@ -40,6 +40,7 @@
 #          Andreas Hansson
 
 from m5.params import *
+from m5.proxy import *
 from MemObject import MemObject
 
 class Bridge(MemObject):
@@ -52,3 +53,9 @@ class Bridge(MemObject):
     delay = Param.Latency('0ns', "The latency of this bridge")
     ranges = VectorParam.AddrRange([AllMemory],
                                    "Address ranges to pass through the bridge")
+    system = Param.System(Parent.any, "System we belong to")
+    # The master side may live on a different event queue than the
+    # bridge itself (the slave side), in which case the delay is the
+    # lookahead of the link between the two queues.
+    master_eventq_index = Param.UInt32(Self.eventq_index,
+                                       "Event queue of the master side")
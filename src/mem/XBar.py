@@ -115,6 +115,11 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize('8MB', "Maximum capacity of snoop filter")
 
+    # Counting Bloom filter in front of the snoop filter, answering
+    # lookups for lines that are certainly not tracked without probing
+    # the snoop filter itself. Must be a power of two, 0 disables it.
+    bloom_filter_entries = Param.Unsigned(0, "Counters in the Bloom filter")
+
 # We use a coherent crossbar to connect multiple masters to the L2
 # caches. Normally this crossbar would be part of the cache itself.
 class L2XBar(CoherentXBar):
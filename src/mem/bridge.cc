@@ -52,16 +52,19 @@
 #include "debug/Bridge.hh"
 #include "mem/bridge.hh"
 #include "params/Bridge.hh"
+#include "sim/system.hh"
 
 Bridge::BridgeSlavePort::BridgeSlavePort(const std::string& _name,
                                          Bridge& _bridge,
                                          BridgeMasterPort& _masterPort,
                                          Cycles _delay, int _resp_limit,
+                                         int _req_limit,
                                          std::vector<AddrRange> _ranges)
     : SlavePort(_name, &_bridge), bridge(_bridge), masterPort(_masterPort),
       delay(_delay), ranges(_ranges.begin(), _ranges.end()),
-      outstandingResponses(0), retryReq(false),
-      respQueueLimit(_resp_limit), sendEvent(*this)
+      outstandingResponses(0), outstandingRequests(0), retryReq(false),
+      respQueueLimit(_resp_limit), reqQueueLimit(_req_limit),
+      sendEvent(*this)
 {
 }
 
@@ -76,11 +79,31 @@ Bridge::BridgeMasterPort::BridgeMasterPort(const std::string& _name,
 
 Bridge::Bridge(Params *p)
     : MemObject(p),
+      masterQueue(getEventQueue(p->master_eventq_index)),
+      crossQueue(masterQueue != eventQueue()),
+      lookahead(ticksToCycles(p->delay) * clockPeriod()),
       slavePort(p->name + ".slave", *this, masterPort,
-                ticksToCycles(p->delay), p->resp_size, p->ranges),
+                ticksToCycles(p->delay), p->resp_size, p->req_size,
+                p->ranges),
       masterPort(p->name + ".master", *this, slavePort,
                  ticksToCycles(p->delay), p->req_size)
 {
+    if (crossQueue && lookahead == 0)
+        fatal("Bridge %s connects two event queues but has no delay\n",
+              name());
+
+    // queued requests may be writes to memory, which functional
+    // accesses through the memory backdoor would not see
+    const AddrRangeList mem_ranges =
+        p->system->getPhysMem().getConfAddrRanges();
+    for (const auto& r : p->ranges) {
+        for (const auto& m : mem_ranges) {
+            if (r.intersects(m)) {
+                p->system->registerWriteBuffer();
+                return;
+            }
+        }
+    }
 }
 
 BaseMasterPort&
@@ -112,6 +135,50 @@ Bridge::init()
 
     // notify the master side  of our address ranges
     slavePort.sendRangeChange();
+
+    // anything crossing the bridge takes at least the bridge delay,
+    // which lets the two event queues run a delay apart
+    if (crossQueue) {
+        declareLookahead(eventQueue()->index(), masterQueue->index(),
+                         lookahead);
+        declareLookahead(masterQueue->index(), eventQueue()->index(),
+                         lookahead);
+    }
+}
+
+void
+Bridge::sendAcross(EventQueue *eq, CrossQueueEvent::Type type,
+                   PacketPtr pkt, Tick when)
+{
+    assert(crossQueue && when >= curTick() + lookahead);
+    eq->schedule(new CrossQueueEvent(*this, type, pkt), when);
+}
+
+Tick
+Bridge::masterClockEdge() const
+{
+    // the bridge clock is only ever updated from the slave side, but
+    // with a fixed clock period the edges are simply its multiples
+    Tick period = clockPeriod();
+    return divCeil(curTick(), period) * period;
+}
+
+void
+Bridge::CrossQueueEvent::process()
+{
+    switch (type) {
+      case Request:
+        bridge.masterPort.schedTimingReq(pkt, curTick(), curTick());
+        break;
+      case Response:
+        // the response left the master side a bridge delay ago, so
+        // the next edge is the one it would have been scheduled for
+        bridge.slavePort.schedTimingResp(pkt, bridge.clockEdge());
+        break;
+      case Credit:
+        bridge.slavePort.releaseRequest();
+        break;
+    }
 }
 
 bool
@@ -126,6 +193,18 @@ Bridge::BridgeMasterPort::reqQueueFull() const
     return transmitList.size() == reqQueueLimit;
 }
 
+bool
+Bridge::BridgeSlavePort::reqQueueFull() const
+{
+    // when crossing event queues we cannot look at the master side,
+    // but we know how many requests we have handed over to it and
+    // how many of those it had sent on a bridge delay ago
+    if (bridge.crossQueue)
+        return outstandingRequests == reqQueueLimit;
+
+    return masterPort.reqQueueFull();
+}
+
 bool
 Bridge::BridgeMasterPort::recvTimingResp(PacketPtr pkt)
 {
@@ -139,7 +218,15 @@ Bridge::BridgeMasterPort::recvTimingResp(PacketPtr pkt)
     // @todo: We need to pay for this and not just zero it out
     pkt->headerDelay = pkt->payloadDelay = 0;
 
-    slavePort.schedTimingResp(pkt, bridge.clockEdge(delay));
+    // the bridge clock is only ever updated from the slave side, so
+    // only add the delay here and align the response to the clock
+    // when it arrives there
+    if (bridge.crossQueue) {
+        bridge.sendAcross(bridge.eventQueue(), CrossQueueEvent::Response,
+                          pkt, curTick() + bridge.lookahead);
+    } else {
+        slavePort.schedTimingResp(pkt, bridge.clockEdge(delay));
+    }
 
     return true;
 }
@@ -157,7 +244,7 @@ Bridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
             transmitList.size(), outstandingResponses);
 
     // if the request queue is full then there is no hope
-    if (masterPort.reqQueueFull()) {
+    if (reqQueueFull()) {
         DPRINTF(Bridge, "Request queue full\n");
         retryReq = true;
     } else {
@@ -183,7 +270,15 @@ Bridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
             // @todo: We need to pay for this and not just zero it out
             pkt->headerDelay = pkt->payloadDelay = 0;
 
-            masterPort.schedTimingReq(pkt, bridge.clockEdge(delay));
+            if (bridge.crossQueue) {
+                ++outstandingRequests;
+                bridge.sendAcross(bridge.masterQueue,
+                                  CrossQueueEvent::Request, pkt,
+                                  bridge.clockEdge(delay));
+            } else {
+                masterPort.schedTimingReq(pkt, bridge.clockEdge(delay),
+                                          curTick());
+            }
         }
     }
 
@@ -194,6 +289,48 @@ Bridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
     return !retryReq;
 }
 
+unsigned
+Bridge::BridgeSlavePort::recvTimingReqBatch(const PacketBatch& batch)
+{
+    // when crossing event queues the packets are handed over as they
+    // arrive, so take them one by one
+    if (bridge.crossQueue)
+        return SlavePort::recvTimingReqBatch(batch);
+
+    // the first packet is due, and is accepted or refused exactly as
+    // it would be on its own
+    if (!recvTimingReq(batch.front().pkt))
+        return 0;
+
+    unsigned accepted = 1;
+    for (auto p = batch.begin() + 1; p != batch.end(); ++p) {
+        PacketPtr pkt = p->pkt;
+        bool expects_response = pkt->needsResponse() &&
+            !pkt->memInhibitAsserted();
+
+        // anything that is due, or does not fit, is left for the
+        // master to send again
+        if (p->when <= curTick() || masterPort.reqQueueFull() ||
+            (expects_response && respQueueFull()))
+            break;
+
+        DPRINTF(Bridge, "recvTimingReqBatch: %s addr 0x%x due at %d\n",
+                pkt->cmdString(), pkt->getAddr(), p->when);
+
+        if (expects_response)
+            ++outstandingResponses;
+
+        // @todo: We need to pay for this and not just zero it out
+        pkt->headerDelay = pkt->payloadDelay = 0;
+
+        masterPort.schedTimingReq(pkt, bridge.clockEdgeAt(p->when, delay),
+                                  p->when);
+        ++accepted;
+    }
+
+    return accepted;
+}
+
 void
 Bridge::BridgeSlavePort::retryStalledReq()
 {
@@ -205,19 +342,41 @@ Bridge::BridgeSlavePort::retryStalledReq()
 }
 
 void
-Bridge::BridgeMasterPort::schedTimingReq(PacketPtr pkt, Tick when)
+Bridge::BridgeSlavePort::releaseRequest()
+{
+    assert(outstandingRequests != 0);
+    --outstandingRequests;
+
+    retryStalledReq();
+}
+
+void
+Bridge::BridgeMasterPort::scheduleSend(Tick when)
+{
+    // the bridge clock is only ever updated from the slave side
+    if (bridge.crossQueue) {
+        bridge.masterQueue->schedule(&sendEvent,
+                                     std::max(when, bridge.masterClockEdge()));
+    } else {
+        bridge.schedule(sendEvent, std::max(when, bridge.clockEdge()));
+    }
+}
+
+void
+Bridge::BridgeMasterPort::schedTimingReq(PacketPtr pkt, Tick when,
+                                         Tick arrival)
 {
     // If we're about to put this packet at the head of the queue, we
     // need to schedule an event to do the transmit.  Otherwise there
     // should already be an event scheduled for sending the head
     // packet.
     if (transmitList.empty()) {
-        bridge.schedule(sendEvent, when);
+        bridge.masterQueue->schedule(&sendEvent, when);
     }
 
     assert(transmitList.size() != reqQueueLimit);
 
-    transmitList.emplace_back(pkt, when);
+    transmitList.emplace_back(pkt, when, arrival);
 }
 
 
@@ -258,15 +417,19 @@ Bridge::BridgeMasterPort::trySendTiming()
         if (!transmitList.empty()) {
             DeferredPacket next_req = transmitList.front();
             DPRINTF(Bridge, "Scheduling next send\n");
-            bridge.schedule(sendEvent, std::max(next_req.tick,
-                                                bridge.clockEdge()));
+            scheduleSend(next_req.tick);
         }
 
         // if we have stalled a request due to a full request queue,
         // then send a retry at this point, also note that if the
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
-        slavePort.retryStalledReq();
+        if (bridge.crossQueue) {
+            bridge.sendAcross(bridge.eventQueue(), CrossQueueEvent::Credit,
+                              nullptr, curTick() + bridge.lookahead);
+        } else {
+            slavePort.retryStalledReq();
+        }
     }
 
     // if the send failed, then we try again once we receive a retry,
@@ -306,7 +469,7 @@ Bridge::BridgeSlavePort::trySendTiming()
         // if there is space in the request queue and we were stalling
         // a request, it will definitely be possible to accept it now
         // since there is guaranteed space in the response queue
-        if (!masterPort.reqQueueFull() && retryReq) {
+        if (!reqQueueFull() && retryReq) {
             DPRINTF(Bridge, "Request waiting for retry, now retrying\n");
             retryReq = false;
             sendRetryReq();
@@ -366,7 +529,9 @@ Bridge::BridgeMasterPort::checkFunctional(PacketPtr pkt)
     auto i = transmitList.begin();
 
     while(i != transmitList.end() && !found) {
-        if (pkt->checkFunctional((*i).pkt)) {
+        // requests accepted ahead of time are not visible until they
+        // are due
+        if ((*i).arrival <= curTick() && pkt->checkFunctional((*i).pkt)) {
             pkt->makeResponse();
             found = true;
         }
@@ -69,6 +69,21 @@
  * before forwarding the request. If there is no space present, then
  * the bridge will delay accepting the packet until space becomes
  * available.
+ *
+ * The master side of the bridge can be placed on a different event
+ * queue than the bridge itself, making the bridge a link between two
+ * simulation threads. Packets then cross over to the other side as
+ * asynchronous events, and request buffer space is accounted for on
+ * the slave side using credits returned by the master side. All
+ * crossings are delayed by the bridge latency, which is declared as
+ * the lookahead of the link.
+ *
+ * Packets are sent out on the same clock edges as when both sides
+ * share an event queue, assuming the clock period does not change.
+ * The credits, however, also take a bridge delay to come back, so
+ * the slave side sees the request queue drain a bridge delay late.
+ * Once the request queue fills up, requests are therefore accepted
+ * later than with a single event queue and timing differs.
  */
 class Bridge : public MemObject
 {
@@ -76,7 +91,9 @@ class Bridge : public MemObject
 
     /**
      * A deferred packet stores a packet along with its scheduled
-     * transmission time
+     * transmission time, and the time it arrived at the bridge. The
+     * latter is in the future for a request accepted ahead of time as
+     * part of a batch.
      */
     class DeferredPacket
     {
@@ -85,9 +102,40 @@ class Bridge : public MemObject
 
         const Tick tick;
         const PacketPtr pkt;
+        const Tick arrival;
+
+        DeferredPacket(PacketPtr _pkt, Tick _tick, Tick _arrival = 0)
+            : tick(_tick), pkt(_pkt), arrival(_arrival)
+        { }
+    };
+
+    /**
+     * Event handing a packet, or a request buffer credit, over to the
+     * other side of a bridge that connects two event queues.
+     */
+    class CrossQueueEvent : public Event
+    {
+
+      public:
+
+        enum Type { Request, Response, Credit };
+
+      private:
+
+        Bridge& bridge;
+        const Type type;
+        const PacketPtr pkt;
 
-        DeferredPacket(PacketPtr _pkt, Tick _tick) : tick(_tick), pkt(_pkt)
+      public:
+
+        CrossQueueEvent(Bridge& _bridge, Type _type, PacketPtr _pkt)
+            : Event(Default_Pri, AutoDelete), bridge(_bridge), type(_type),
+              pkt(_pkt)
         { }
+
+        void process();
+
+        const char *description() const { return "bridge crossing"; }
     };
 
     // Forward declaration to allow the slave port to have a pointer
@@ -129,12 +177,24 @@ class Bridge : public MemObject
         /** Counter to track the outstanding responses. */
         unsigned int outstandingResponses;
 
+        /**
+         * Counter to track the requests handed over to the master
+         * side whose credit has not come back yet, i.e., the
+         * occupancy of the master side request queue as of a bridge
+         * delay ago. Only used when the two sides are on different
+         * event queues.
+         */
+        unsigned int outstandingRequests;
+
         /** If we should send a retry when space becomes available. */
         bool retryReq;
 
         /** Max queue size for reserved responses. */
         unsigned int respQueueLimit;
 
+        /** Max queue size for requests on the master side. */
+        const unsigned int reqQueueLimit;
+
         /**
          * Is this side blocked from accepting new response packets.
          *
@@ -142,6 +202,14 @@ class Bridge : public MemObject
          */
         bool respQueueFull() const;
 
+        /**
+         * Is the master side blocked from accepting new request
+         * packets, as far as this side can tell.
+         *
+         * @return true if the occupied space has reached the set limit
+         */
+        bool reqQueueFull() const;
+
         /**
          * Handle send event, scheduled when the packet at the head of
          * the response queue is ready to transmit (for timing
@@ -163,11 +231,13 @@ class Bridge : public MemObject
          * @param _masterPort the master port on the other side of the bridge
          * @param _delay the delay in cycles from receiving to sending
          * @param _resp_limit the size of the response queue
+         * @param _req_limit the size of the master side request queue
          * @param _ranges a number of address ranges to forward
          */
         BridgeSlavePort(const std::string& _name, Bridge& _bridge,
                         BridgeMasterPort& _masterPort, Cycles _delay,
-                        int _resp_limit, std::vector<AddrRange> _ranges);
+                        int _resp_limit, int _req_limit,
+                        std::vector<AddrRange> _ranges);
 
         /**
          * Queue a response packet to be sent out later and also schedule
@@ -185,12 +255,35 @@ class Bridge : public MemObject
          */
         void retryStalledReq();
 
+        /**
+         * Take batches of timing requests, unless the two sides of
+         * the bridge are on different event queues.
+         */
+        bool acceptsTimingReqBatch() const { return !bridge.crossQueue; }
+
+        /**
+         * Account for a request that has left the master side of a
+         * bridge connecting two event queues, and retry any request
+         * stalled waiting for space.
+         */
+        void releaseRequest();
+
       protected:
 
         /** When receiving a timing request from the peer port,
             pass it to the bridge. */
         bool recvTimingReq(PacketPtr pkt);
 
+        /**
+         * When receiving a batch of timing requests from the peer
+         * port, take the packets that are not yet due as long as
+         * there is space for them and their responses. The space
+         * is checked as of now, as if nothing leaves the queues
+         * before the packets are due, so a packet is at worst left
+         * for the master to send again.
+         */
+        unsigned recvTimingReqBatch(const PacketBatch& batch);
+
         /** When receiving a retry request from the peer port,
             pass it to the bridge. */
         void recvRespRetry();
@@ -252,6 +345,13 @@ class Bridge : public MemObject
         EventWrapper<BridgeMasterPort,
                      &BridgeMasterPort::trySendTiming> sendEvent;
 
+        /**
+         * Schedule the send event on the master side event queue.
+         *
+         * @param when earliest tick at which the head packet is ready
+         */
+        void scheduleSend(Tick when);
+
       public:
 
         /**
@@ -280,12 +380,13 @@ class Bridge : public MemObject
          *
          * @param pkt a request to send out after a delay
          * @param when tick when response packet should be sent
+         * @param arrival tick when the request arrives at the bridge
          */
-        void schedTimingReq(PacketPtr pkt, Tick when);
+        void schedTimingReq(PacketPtr pkt, Tick when, Tick arrival);
 
         /**
          * Check a functional request against the packets in our
-         * request queue.
+         * request queue that have arrived.
          *
          * @param pkt packet to check against
          *
@@ -304,6 +405,37 @@ class Bridge : public MemObject
         void recvReqRetry();
     };
 
+    /**
+     * Event queue of the master side. This is the event queue of the
+     * bridge itself unless the bridge connects two event queues.
+     */
+    EventQueue *const masterQueue;
+
+    /** Are the two sides of the bridge on different event queues. */
+    const bool crossQueue;
+
+    /** Bridge delay in ticks, the lookahead between the two sides. */
+    const Tick lookahead;
+
+    /**
+     * Hand a packet or a credit over to the other side of a bridge
+     * connecting two event queues.
+     *
+     * @param eq event queue of the receiving side
+     * @param type what is being handed over
+     * @param pkt packet to hand over, if any
+     * @param when tick at which the other side receives it
+     */
+    void sendAcross(EventQueue *eq, CrossQueueEvent::Type type,
+                    PacketPtr pkt, Tick when);
+
+    /**
+     * Next clock edge of the bridge as seen from the master side of a
+     * bridge connecting two event queues, which must not touch the
+     * clock state of the bridge.
+     */
+    Tick masterClockEdge() const;
+
     /** Slave port of the bridge. */
     BridgeSlavePort slavePort;
 
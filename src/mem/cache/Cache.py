@@ -75,6 +75,9 @@ class BaseCache(MemObject):
     tags = Param.BaseTags(LRU(), "Tag store (replacement policy)")
     sequential_access = Param.Bool(False,
         "Whether to access tags and data sequentially")
+    tag_index = Param.Bool(False,
+        "Whether to look up tags through a hash index, which speeds up "
+        "the simulation of highly associative caches")
 
     cpu_side = SlavePort("Upstream port closer to the CPU and/or device")
     mem_side = MasterPort("Downstream port closer to memory")
@@ -86,6 +86,9 @@ BaseCache::BaseCache(const BaseCacheParams *p, unsigned blk_size)
       addrRanges(p->addr_ranges.begin(), p->addr_ranges.end()),
       system(p->system)
 {
+    // the cache may hold dirty data, the memory is no longer a safe
+    // backdoor for functional accesses once the simulation starts
+    system->registerCache();
 }
 
 void
@@ -60,6 +60,9 @@ class BaseSetAssoc(BaseTags):
     assoc = Param.Int(Parent.assoc, "associativity")
     sequential_access = Param.Bool(Parent.sequential_access,
         "Whether to access tags and data sequentially")
+    tag_index = Param.Bool(Parent.tag_index,
+        "Whether to look up tags through a hash index rather than by "
+        "searching all ways, only affects simulation speed")
 
 class LRU(BaseSetAssoc):
     type = 'LRU'
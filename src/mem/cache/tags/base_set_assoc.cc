@@ -56,7 +56,7 @@ using namespace std;
 BaseSetAssoc::BaseSetAssoc(const Params *p)
     :BaseTags(p), assoc(p->assoc), allocAssoc(p->assoc),
      numSets(p->size / (p->block_size * p->assoc)),
-     sequentialAccess(p->sequential_access)
+     sequentialAccess(p->sequential_access), tagIndex(NULL)
 {
     // Check parameters
     if (blkSize < 4 || !isPowerOf2(blkSize)) {
@@ -78,6 +78,8 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
 
     sets = new SetType[numSets];
     blks = new BlkType[numSets * assoc];
+    if (p->tag_index)
+        tagIndex = new TagIndex<BlkType>(numSets * assoc, blkSize);
     // allocate data storage in one big chunk
     numBlocks = numSets * assoc;
     dataBlks = new uint8_t[numBlocks * blkSize];
@@ -115,6 +117,7 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
 
 BaseSetAssoc::~BaseSetAssoc()
 {
+    delete tagIndex;
     delete [] dataBlks;
     delete [] blks;
     delete [] sets;
@@ -125,7 +128,7 @@ BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
 {
     Addr tag = extractTag(addr);
     unsigned set = extractSet(addr);
-    BlkType *blk = sets[set].findBlk(tag, is_secure);
+    BlkType *blk = lookup(tag, set, is_secure);
     return blk;
 }
 
@@ -54,6 +54,7 @@
 
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/cacheset.hh"
+#include "mem/cache/tags/tag_index.hh"
 #include "mem/cache/base.hh"
 #include "mem/cache/blk.hh"
 #include "mem/packet.hh"
@@ -97,6 +98,12 @@ class BaseSetAssoc : public BaseTags
     /** The cache sets. */
     SetType *sets;
 
+    /**
+     * Optional hash index over the blocks, used instead of searching
+     * all the ways of a set when looking up a tag. NULL if disabled.
+     */
+    TagIndex<BlkType> *tagIndex;
+
     /** The cache blocks. */
     BlkType *blks;
     /** The data blocks, 1 per cache block. */
@@ -111,6 +118,23 @@ class BaseSetAssoc : public BaseTags
     /** Mask out all bits that aren't part of the block offset. */
     unsigned blkMask;
 
+    /**
+     * Find a valid block in a set, either through the tag index or by
+     * searching all the ways of the set.
+     * @param tag The tag to find.
+     * @param set The set to search.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    BlkType*
+    lookup(Addr tag, int set, bool is_secure) const
+    {
+        if (tagIndex)
+            return tagIndex->find(regenerateBlkAddr(tag, set), is_secure);
+
+        return sets[set].findBlk(tag, is_secure);
+    }
+
 public:
 
     /** Convenience typedef. */
@@ -207,7 +231,7 @@ public:
     {
         Addr tag = extractTag(addr);
         int set = extractSet(addr);
-        BlkType *blk = sets[set].findBlk(tag, is_secure);
+        BlkType *blk = lookup(tag, set, is_secure);
         lat = accessLatency;;
 
         // Access all tags in parallel, hence one in each way.  The data side
@@ -306,7 +330,11 @@ public:
          blk->isTouched = true;
 
          // Set tag for new block.  Caller is responsible for setting status.
+         if (tagIndex)
+             tagIndex->erase(regenerateBlkAddr(blk->tag, blk->set), blk);
          blk->tag = extractTag(addr);
+         if (tagIndex)
+             tagIndex->insert(blkAlign(addr), blk);
 
          // deal with what we are bringing in
          assert(master_id < cache->system->maxMasters());
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a hash index over the blocks of a tag store
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_INDEX_HH__
+#define __MEM_CACHE_TAGS_TAG_INDEX_HH__
+
+#include <cassert>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * An open-addressed hash table mapping block addresses to the cache
+ * blocks that were last filled with them.
+ *
+ * Entries are only added and removed when a block gets a new tag, and
+ * are not touched when blocks are invalidated. A lookup instead checks
+ * the validity and security state of every block with a matching
+ * address, exactly like a scan over the ways of a set would. This
+ * keeps the index correct whatever way the owner of the blocks
+ * changes their status, and there are never more entries than blocks.
+ */
+template <class Blktype>
+class TagIndex
+{
+  private:
+    struct Entry
+    {
+        Addr blkAddr;
+        /** Block filled with blkAddr, NULL if the slot is empty. */
+        Blktype *blk;
+    };
+
+    /** Slots, kept at most half full for short probe sequences. */
+    std::vector<Entry> table;
+
+    /** Number of slots minus one. */
+    const size_t mask;
+
+    /** The amount to shift a block address to drop the offset. */
+    const int blkShift;
+
+    /** Home slot of a block address. */
+    size_t
+    home(Addr blk_addr) const
+    {
+        // Fibonacci hashing, the upper bits of the product are the
+        // well mixed ones
+        const uint64_t golden = 0x9e3779b97f4a7c15ULL;
+        return ((blk_addr >> blkShift) * golden >> 32) & mask;
+    }
+
+  public:
+    /**
+     * @param num_blocks Number of blocks in the tag store.
+     * @param blk_size Block size in bytes.
+     */
+    TagIndex(unsigned num_blocks, unsigned blk_size)
+        : table(2 * ceilPow2(num_blocks), Entry{0, nullptr}),
+          mask(table.size() - 1), blkShift(floorLog2(blk_size))
+    {
+    }
+
+    /**
+     * Find the valid block holding a block address.
+     * @param blk_addr The block address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the block if found.
+     */
+    Blktype*
+    find(Addr blk_addr, bool is_secure) const
+    {
+        for (size_t i = home(blk_addr); table[i].blk; i = (i + 1) & mask) {
+            Blktype *blk = table[i].blk;
+            if (table[i].blkAddr == blk_addr && blk->isValid() &&
+                blk->isSecure() == is_secure) {
+                return blk;
+            }
+        }
+
+        return NULL;
+    }
+
+    /**
+     * Record that a block has been filled with a block address.
+     * @param blk_addr The block address.
+     * @param blk The block.
+     */
+    void
+    insert(Addr blk_addr, Blktype *blk)
+    {
+        size_t i = home(blk_addr);
+        while (table[i].blk) {
+            assert(table[i].blk != blk);
+            i = (i + 1) & mask;
+        }
+
+        table[i].blkAddr = blk_addr;
+        table[i].blk = blk;
+    }
+
+    /**
+     * Remove the entry of a block, if it has one.
+     * @param blk_addr The block address the block was filled with.
+     * @param blk The block.
+     */
+    void
+    erase(Addr blk_addr, Blktype *blk)
+    {
+        size_t i = home(blk_addr);
+        while (table[i].blk != blk) {
+            if (!table[i].blk)
+                return;
+            i = (i + 1) & mask;
+        }
+
+        // Close the gap by moving back any later entry of the probe
+        // sequence whose home slot is not between the gap and itself.
+        for (size_t j = (i + 1) & mask; table[j].blk; j = (j + 1) & mask) {
+            size_t k = home(table[j].blkAddr);
+            bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (!stays) {
+                table[i] = table[j];
+                i = j;
+            }
+        }
+
+        table[i].blk = nullptr;
+    }
+};
+
+#endif //__MEM_CACHE_TAGS_TAG_INDEX_HH__
@@ -137,6 +137,12 @@ CoherentXBar::init()
         snoopFilter->setSlavePorts(slavePorts);
 }
 
+bool
+CoherentXBar::needsSnoop() const
+{
+    return !system->bypassCaches() && (!snoopPorts.empty() || snoopFilter);
+}
+
 bool
 CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
 {
@@ -103,6 +103,16 @@ class CoherentXBar : public BaseXBar
               queue(_xbar, *this)
         { }
 
+        /**
+         * Take batches of timing requests if there is no one to snoop
+         * and any of the destinations takes batches.
+         */
+        virtual bool acceptsTimingReqBatch() const
+        {
+            return !xbar.needsSnoop() &&
+                xbar.anyDestAcceptsTimingReqBatch();
+        }
+
       protected:
 
         /**
@@ -111,6 +121,20 @@ class CoherentXBar : public BaseXBar
         virtual bool recvTimingReq(PacketPtr pkt)
         { return xbar.recvTimingReq(pkt, id); }
 
+        /**
+         * When receiving a batch of timing requests, pass it to the
+         * crossbar if there is no one to snoop and the destination
+         * takes batches, and otherwise pass on the packets that are
+         * due one by one.
+         */
+        virtual unsigned recvTimingReqBatch(const PacketBatch& batch)
+        {
+            return !xbar.needsSnoop() &&
+                xbar.destAcceptsTimingReqBatch(batch) ?
+                xbar.forwardTimingReqBatch(batch, id, xbar.reqLayers) :
+                QueuedSlavePort::recvTimingReqBatch(batch);
+        }
+
         /**
          * When receiving a timing snoop response, pass it to the crossbar.
          */
@@ -280,6 +304,13 @@ class CoherentXBar : public BaseXBar
      */
     std::vector<PacketPtr> pendingDelete;
 
+    /**
+     * Determine if requests are snooped. The snoops have to happen at
+     * the tick a request is due, and batches of requests are then
+     * taken apart rather than forwarded.
+     */
+    bool needsSnoop() const;
+
     /** Function called by the port when the crossbar is recieving a Timing
       request packet.*/
     bool recvTimingReq(PacketPtr pkt, PortID slave_port_id);
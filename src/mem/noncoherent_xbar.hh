@@ -102,6 +102,13 @@ class NoncoherentXBar : public BaseXBar
               queue(_xbar, *this)
         { }
 
+        /**
+         * Take batches of timing requests if any of the destinations
+         * does.
+         */
+        virtual bool acceptsTimingReqBatch() const
+        { return xbar.anyDestAcceptsTimingReqBatch(); }
+
       protected:
 
         /**
@@ -110,6 +117,18 @@ class NoncoherentXBar : public BaseXBar
         virtual bool recvTimingReq(PacketPtr pkt)
         { return xbar.recvTimingReq(pkt, id); }
 
+        /**
+         * When receiving a batch of timing requests, pass it to the
+         * crossbar if the destination takes batches, and otherwise
+         * pass on the packets that are due one by one.
+         */
+        virtual unsigned recvTimingReqBatch(const PacketBatch& batch)
+        {
+            return xbar.destAcceptsTimingReqBatch(batch) ?
+                xbar.forwardTimingReqBatch(batch, id, xbar.reqLayers) :
+                QueuedSlavePort::recvTimingReqBatch(batch);
+        }
+
         /**
          * When receiving an atomic request, pass it to the crossbar.
          */
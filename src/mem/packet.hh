@@ -60,6 +60,7 @@
 #include "base/compiler.hh"
 #include "base/flags.hh"
 #include "base/misc.hh"
+#include "base/pool_alloc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/request.hh"
@@ -233,7 +234,7 @@ class MemCmd
  * ultimate destination and back, possibly being conveyed by several
  * different Packets along the way.)
  */
-class Packet : public Printable
+class Packet : public Printable, public PoolAllocated<Packet>
 {
   public:
     typedef uint32_t FlagsType;
@@ -266,6 +267,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was allocated by the packet itself from
+        /// the buffer pool, and is returned there when freed
+        POOL_DATA              = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -959,10 +963,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOL_DATA))
+            BufferPool::release(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOL_DATA);
         data = NULL;
     }
 
@@ -971,8 +977,8 @@ class Packet : public Printable
     allocate()
     {
         assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-        flags.set(DYNAMIC_DATA);
-        data = new uint8_t[getSize()];
+        flags.set(DYNAMIC_DATA|POOL_DATA);
+        data = BufferPool::allocate(getSize());
     }
 
     /** @} */
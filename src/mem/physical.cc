@@ -38,18 +38,27 @@
  */
 
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 
+#include "base/blake2b.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
@@ -70,15 +79,187 @@
 
 using namespace std;
 
+namespace {
+
+/**
+ * Number of 64-bit words in the hash of a page.
+ */
+const unsigned hashWords = 4;
+
+/**
+ * Check whether a page is all zeros, stopping at the first non-zero
+ * word.
+ */
+bool
+isZeroPage(const uint8_t* page, uint64_t page_size)
+{
+    const uint64_t* words = (const uint64_t*)page;
+    uint64_t any = 0;
+    for (uint64_t i = 0; i < page_size / sizeof(uint64_t) && !any; ++i)
+        any |= words[i];
+    return !any;
+}
+
+/**
+ * Hash of a page, used to tell whether a page changed since the last
+ * checkpoint. A page whose hash did not change is left out of an
+ * incremental checkpoint, so the hash is a cryptographic one rather
+ * than one that merely spreads the pages well. All-zero pages are
+ * common and not hashed, they get the precomputed zero_hash instead.
+ *
+ * @return Whether the page is all zeros
+ */
+bool
+hashPage(const uint8_t* page, uint64_t page_size,
+         const uint64_t* zero_hash, uint64_t* hash)
+{
+    const bool zero = isZeroPage(page, page_size);
+
+    const uint64_t hash_size = hashWords * sizeof(uint64_t);
+    if (zero)
+        memcpy(hash, zero_hash, hash_size);
+    else
+        blake2b((uint8_t*)hash, hash_size, page, page_size);
+    return zero;
+}
+
+bool
+testBit(const vector<uint8_t>& map, uint64_t i)
+{
+    return map[i / 8] & (1 << (i % 8));
+}
+
+bool
+writeAll(int fd, const uint8_t* buf, uint64_t len, uint64_t offset)
+{
+    while (len) {
+        ssize_t ret = pwrite(fd, buf, min<uint64_t>(len, INT_MAX), offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        buf += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+bool
+readAll(int fd, uint8_t* buf, uint64_t len, uint64_t offset)
+{
+    while (len) {
+        ssize_t ret = pread(fd, buf, min<uint64_t>(len, INT_MAX), offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        buf += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+/**
+ * Absolute path of a directory, ending in '/', so that the layers of
+ * checkpoints can be compared and located relative to each other.
+ */
+string
+canonicalDir(const string& dir)
+{
+    char* path = realpath(dir.c_str(), NULL);
+    if (!path)
+        fatal("Can't resolve checkpoint directory '%s'\n", dir);
+
+    string result(path);
+    free(path);
+    return result + "/";
+}
+
+/**
+ * Run func(i) for every i in [0, n) on a number of threads. The
+ * callback must not call fatal or panic as it may run on any thread.
+ */
+template <class F>
+void
+parallelFor(unsigned threads, uint64_t n, F func)
+{
+    threads = min<uint64_t>(threads, n);
+    if (threads <= 1) {
+        for (uint64_t i = 0; i < n; ++i)
+            func(i);
+        return;
+    }
+
+    mutex lock;
+    uint64_t next = 0;
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            while (true) {
+                uint64_t i;
+                {
+                    lock_guard<mutex> l(lock);
+                    if (next == n)
+                        return;
+                    i = next++;
+                }
+                func(i);
+            }
+        });
+    }
+
+    for (auto& w : workers)
+        w.join();
+}
+
+/**
+ * Express the path of a layer relative to the checkpoint directory
+ * it is referenced from, so that the checkpoints of a run can be
+ * moved around together.
+ */
+string
+layerPath(const string& dir, const string& filename, const string& cpt_dir)
+{
+    if (dir == cpt_dir)
+        return filename;
+
+    auto parent = [](const string& d) {
+        size_t pos = d.find_last_of('/', d.size() - 2);
+        return pos == string::npos ? string() : d.substr(0, pos + 1);
+    };
+
+    string base = parent(dir);
+    if (base == parent(cpt_dir))
+        return "../" + dir.substr(base.size()) + filename;
+
+    return dir + filename;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
+                               bool mmap_using_noreserve,
+                               uint64_t cpt_chunk_size, unsigned cpt_threads,
+                               bool cpt_compress, bool cpt_incremental,
+                               bool cpt_image) :
     _name(_name), rangeCache(addrMap.end()), size(0),
-    mmapUsingNoReserve(mmap_using_noreserve)
+    mmapUsingNoReserve(mmap_using_noreserve),
+    cptChunkSize(cpt_chunk_size),
+    cptThreads(cpt_threads ? cpt_threads :
+               max(thread::hardware_concurrency(), 1u)),
+    cptCompress(cpt_compress), cptIncremental(cpt_incremental),
+    cptImage(cpt_image), backdoorEnabled(false), hostGeneration(0)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    fatal_if(cptChunkSize == 0 || cptChunkSize % sysconf(_SC_PAGESIZE),
+             "Memory checkpoint chunk size %d is not a multiple of the "
+             "page size\n", cptChunkSize);
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -186,6 +367,11 @@ PhysicalMemory::createBackingStore(AddrRange range,
     // it appropriately
     backingStore.push_back(make_pair(range, pmem));
 
+    // only stores in the global address map can be reached by
+    // physical addresses
+    if (_memories.front()->isInAddrMap())
+        mappedStores.push_back(backingStore.size() - 1);
+
     // point the memories to their backing store
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
@@ -201,6 +387,22 @@ PhysicalMemory::~PhysicalMemory()
         munmap((char*)s.second, s.first.size());
 }
 
+uint8_t*
+PhysicalMemory::hostAddr(Addr addr, Addr size) const
+{
+    if (size == 0)
+        return NULL;
+
+    for (auto i : mappedStores) {
+        const AddrRange& range = backingStore[i].first;
+        if (addr >= range.start() && addr + size - 1 <= range.end() &&
+            addr + size - 1 >= addr)
+            return backingStore[i].second + (addr - range.start());
+    }
+
+    return NULL;
+}
+
 bool
 PhysicalMemory::isMemAddr(Addr addr) const
 {
@@ -334,34 +536,300 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
-    // write memory file
-    string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    const uint64_t chunk_size = cptChunkSize;
+    const uint64_t pages_per_chunk = chunk_size / page_size;
+    const uint64_t nbr_of_pages = divCeil(range.size(), page_size);
+    const uint64_t nbr_of_chunks = divCeil(range.size(), chunk_size);
+
+    if (storeLayers.size() <= store_id) {
+        storeLayers.resize(store_id + 1);
+        pageHashes.resize(store_id + 1);
+    }
+
+    const string dir = canonicalDir(CheckpointIn::dir());
+
+    // an incremental checkpoint is only possible if we know what the
+    // memory looked like at the time of the last checkpoint, and if it
+    // does not replace one of the layers it builds on
+    vector<StoreLayer>& layers = storeLayers[store_id];
+    vector<uint64_t>& hashes = pageHashes[store_id];
+    const bool replaces_layer =
+        any_of(layers.begin(), layers.end(), [&](const StoreLayer& l) {
+                return l.dir == dir && l.filename == filename;
+            });
+    const bool incremental = cptIncremental && !layers.empty() &&
+        !replaces_layer && hashes.size() == nbr_of_pages * hashWords;
+    if (!incremental)
+        layers.clear();
+
+    // only full checkpoints can be stored as an image, as the pages
+    // left out of an incremental one are not zero
+    const bool image = cptImage && !incremental;
+
+    // the pages are only hashed if the hashes are kept for the next
+    // checkpoint, a plain checkpoint merely skips the all-zero pages
+    vector<uint64_t> new_hashes;
+    uint64_t zero_hash[hashWords];
+    if (cptIncremental) {
+        new_hashes.resize(nbr_of_pages * hashWords);
+        vector<uint8_t> zero_page(page_size, 0);
+        blake2b((uint8_t*)zero_hash, sizeof(zero_hash), zero_page.data(),
+                page_size);
+    }
+
+    StoreLayer layer;
+    layer.dir = dir;
+    layer.filename = filename;
+    layer.compressed = cptCompress && !image;
+    layer.image = image;
+    if (!image) {
+        layer.chunkOffsets.resize(nbr_of_chunks, 0);
+        layer.chunkSizes.resize(nbr_of_chunks, 0);
+    }
+
+    // Write memory file. The file we are replacing may still be mapped
+    // as the store if we restored from this checkpoint, and truncating
+    // it would pull the pages from under the mapping. Unlinking it
+    // keeps the old file around for as long as it is mapped.
+    string filepath = layer.dir + filename;
+    unlink(filepath.c_str());
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0664);
+    if (fd < 0)
         fatal("Can't open physical memory checkpoint file '%s'\n",
               filename);
 
-    uint64_t pass_size = 0;
+    // An image is a plain copy of the store in which all-zero pages
+    // are left as holes, written directly by the workers.
+    if (image && ftruncate(fd, nbr_of_pages * page_size))
+        fatal("Can't size physical memory checkpoint file '%s'\n",
+              filename);
 
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+    // Every chunk starts with a map of the pages it holds, followed by
+    // those pages, and is compressed as a whole. Uncompressed chunks
+    // have their map padded to a page and start on a page boundary so
+    // that the pages can be mapped from the file on restore.
+    struct Chunk
+    {
+        Chunk() : pages(0), done(false), failed(false) {}
+        vector<uint8_t> data;
+        uint64_t pages;
+        bool done;
+        bool failed;
+    };
+    vector<Chunk> chunks(nbr_of_chunks);
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+    auto pack = [&](uint64_t c) {
+        Chunk& chunk = chunks[c];
+        const uint64_t first = c * pages_per_chunk;
+        const uint64_t num = min(pages_per_chunk, nbr_of_pages - first);
+        const uint64_t map_size = divCeil(num, 8);
+
+        vector<uint8_t> map(map_size, 0);
+        chunk.pages = 0;
+        for (uint64_t p = 0; p < num; ++p) {
+            const uint8_t* page = pmem + (first + p) * page_size;
+            bool zero;
+            bool changed = false;
+            if (cptIncremental) {
+                uint64_t* h = &new_hashes[(first + p) * hashWords];
+                zero = hashPage(page, page_size, zero_hash, h);
+                changed = incremental &&
+                    memcmp(h, &hashes[(first + p) * hashWords],
+                           hashWords * sizeof(uint64_t));
+            } else {
+                zero = isZeroPage(page, page_size);
+            }
+            if (incremental ? changed : !zero) {
+                map[p / 8] |= 1 << (p % 8);
+                ++chunk.pages;
+            }
+        }
+
+        if (!chunk.pages)
+            return;
+
+        if (image) {
+            for (uint64_t p = 0; p < num && !chunk.failed; ) {
+                uint64_t q = p;
+                while (q < num && testBit(map, q))
+                    ++q;
+                if (q > p) {
+                    const uint64_t offset = (first + p) * page_size;
+                    chunk.failed = !writeAll(fd, pmem + offset,
+                                             (q - p) * page_size, offset);
+                }
+                p = q + 1;
+            }
+            return;
+        }
+
+        if (!cptCompress) {
+            // the pages are written straight from memory
+            map.resize(roundUp(map_size, page_size), 0);
+            chunk.data.swap(map);
+            return;
+        }
+
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if (deflateInit(&zs, Z_BEST_SPEED) != Z_OK) {
+            chunk.failed = true;
+            return;
+        }
+
+        chunk.data.resize(deflateBound(&zs,
+                                       map_size + chunk.pages * page_size));
+        zs.next_out = chunk.data.data();
+        zs.avail_out = chunk.data.size();
+
+        zs.next_in = map.data();
+        zs.avail_in = map_size;
+        int ret = deflate(&zs, Z_NO_FLUSH);
+        for (uint64_t p = 0; p < num && ret == Z_OK; ++p) {
+            if (testBit(map, p)) {
+                zs.next_in = pmem + (first + p) * page_size;
+                zs.avail_in = page_size;
+                ret = deflate(&zs, Z_NO_FLUSH);
+            }
+        }
+        if (ret == Z_OK)
+            ret = deflate(&zs, Z_FINISH);
+
+        chunk.failed = ret != Z_STREAM_END;
+        chunk.data.resize(zs.total_out);
+        deflateEnd(&zs);
+    };
+
+    // Compress the chunks on a set of worker threads while this thread
+    // writes them out in order. The workers are kept at most a few
+    // chunks ahead of the writer to bound the memory used.
+    mutex lock;
+    condition_variable cond;
+    uint64_t next = 0;
+    uint64_t written = 0;
+    const uint64_t window = 2 * cptThreads;
+
+    auto worker = [&]() {
+        unique_lock<mutex> l(lock);
+        while (true) {
+            cond.wait(l, [&]() {
+                return next == nbr_of_chunks || next < written + window;
+            });
+            if (next == nbr_of_chunks)
+                return;
+            uint64_t c = next++;
+            l.unlock();
+            pack(c);
+            l.lock();
+            chunks[c].done = true;
+            cond.notify_all();
         }
+    };
+
+    vector<thread> workers;
+    for (unsigned t = 0; t < min<uint64_t>(cptThreads, nbr_of_chunks); ++t)
+        workers.emplace_back(worker);
+
+    uint64_t offset = 0;
+    uint64_t stored_pages = 0;
+    bool ok = true;
+    for (uint64_t c = 0; c < nbr_of_chunks; ++c) {
+        {
+            unique_lock<mutex> l(lock);
+            cond.wait(l, [&]() { return chunks[c].done; });
+        }
+
+        Chunk& chunk = chunks[c];
+        ok = ok && !chunk.failed;
+        stored_pages += chunk.pages;
+        if (ok && chunk.pages && !image) {
+            if (!cptCompress)
+                offset = roundUp(offset, page_size);
+
+            layer.chunkOffsets[c] = offset;
+            ok = writeAll(fd, chunk.data.data(), chunk.data.size(), offset);
+            offset += chunk.data.size();
+
+            if (!cptCompress) {
+                // write the runs of consecutive pages in one go
+                const uint64_t first = c * pages_per_chunk;
+                const uint64_t num =
+                    min(pages_per_chunk, nbr_of_pages - first);
+                for (uint64_t p = 0; p < num && ok; ) {
+                    uint64_t q = p;
+                    while (q < num && testBit(chunk.data, q))
+                        ++q;
+                    uint64_t len = (q - p) * page_size;
+                    if (len) {
+                        ok = writeAll(fd, pmem + (first + p) * page_size,
+                                      len, offset);
+                        offset += len;
+                    }
+                    p = max(q, p + 1);
+                }
+            }
+
+            layer.chunkSizes[c] = offset - layer.chunkOffsets[c];
+        }
+
+        vector<uint8_t>().swap(chunk.data);
+
+        lock_guard<mutex> l(lock);
+        ++written;
+        cond.notify_all();
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
+    for (auto& w : workers)
+        w.join();
+
+    if (!ok)
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              filename);
+
+    if (close(fd))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
               filename);
 
+    DPRINTF(Checkpoint, "Stored %d of %d pages of %s (%s)\n",
+            stored_pages, nbr_of_pages, filename,
+            incremental ? "incremental" : image ? "image" : "full");
+
+    layers.push_back(layer);
+
+    // remember the page hashes for the next incremental checkpoint,
+    // also across a restore
+    if (cptIncremental) {
+        hashes.swap(new_hashes);
+        string hashpath = filepath + ".hashes";
+        unlink(hashpath.c_str());
+        int hfd = open(hashpath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0664);
+        if (hfd < 0 ||
+            !writeAll(hfd, (const uint8_t*)hashes.data(),
+                      hashes.size() * sizeof(uint64_t), 0) ||
+            close(hfd))
+            fatal("Write failed on physical memory checkpoint file '%s'\n",
+                  hashpath);
+    } else {
+        hashes.clear();
+    }
+
+    unsigned format = 2;
+    SERIALIZE_SCALAR(format);
+    SERIALIZE_SCALAR(page_size);
+    SERIALIZE_SCALAR(chunk_size);
+
+    unsigned nbr_of_layers = layers.size();
+    SERIALIZE_SCALAR(nbr_of_layers);
+    for (unsigned i = 0; i < nbr_of_layers; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("layer%d", i));
+        const StoreLayer& l = layers[i];
+        paramOut(cp, "filename", layerPath(l.dir, l.filename, layer.dir));
+        paramOut(cp, "compressed", l.compressed);
+        paramOut(cp, "image", l.image);
+        arrayParamOut(cp, "chunk_offsets", l.chunkOffsets);
+        arrayParamOut(cp, "chunk_sizes", l.chunkSizes);
+    }
 }
 
 void
@@ -392,8 +860,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -401,13 +867,10 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     string filepath = cp.cptDir + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
-    // we've already got the actual backing store mapped
+    // we've already got the actual backing store mapped, but its
+    // contents are about to be replaced and parts of it remapped
     uint8_t* pmem = backingStore[store_id].second;
+    ++hostGeneration;
     AddrRange range = backingStore[store_id].first;
 
     long range_size;
@@ -420,6 +883,245 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    if (storeLayers.size() <= store_id) {
+        storeLayers.resize(store_id + 1);
+        pageHashes.resize(store_id + 1);
+    }
+
+    vector<StoreLayer>& layers = storeLayers[store_id];
+    vector<uint64_t>& hashes = pageHashes[store_id];
+    layers.clear();
+    hashes.clear();
+
+    // checkpoints without a format are a single gzip stream
+    unsigned format = 1;
+    optParamIn(cp, "format", format, false);
+    if (format == 1) {
+        unserializeStoreStream(filepath, pmem, range);
+        return;
+    }
+
+    if (format != 2)
+        fatal("Unknown format %d of physical memory checkpoint '%s'\n",
+              format, filename);
+
+    uint64_t page_size;
+    uint64_t chunk_size;
+    unsigned nbr_of_layers;
+    UNSERIALIZE_SCALAR(page_size);
+    UNSERIALIZE_SCALAR(chunk_size);
+    UNSERIALIZE_SCALAR(nbr_of_layers);
+
+    // apply the layers from the oldest checkpoint to this one
+    for (unsigned i = 0; i < nbr_of_layers; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("layer%d", i));
+        StoreLayer layer;
+        string path;
+        paramIn(cp, "filename", path);
+        if (path[0] != '/')
+            path = cp.cptDir + "/" + path;
+
+        size_t pos = path.find_last_of('/');
+        layer.dir = canonicalDir(path.substr(0, pos + 1));
+        layer.filename = path.substr(pos + 1);
+        paramIn(cp, "compressed", layer.compressed);
+        layer.image = false;
+        optParamIn(cp, "image", layer.image, false);
+        arrayParamIn(cp, "chunk_offsets", layer.chunkOffsets);
+        arrayParamIn(cp, "chunk_sizes", layer.chunkSizes);
+
+        unserializeLayer(layer, pmem, range, chunk_size, page_size);
+        layers.push_back(layer);
+    }
+
+    // pick up the page hashes to make the next checkpoint an
+    // incremental one on top of this checkpoint, if possible
+    if (cptIncremental) {
+        const uint64_t nbr_of_pages = divCeil(range.size(), page_size);
+        string hashpath = filepath + ".hashes";
+        int hfd = open(hashpath.c_str(), O_RDONLY);
+        if (hfd >= 0 && page_size == sysconf(_SC_PAGESIZE) &&
+            chunk_size == cptChunkSize) {
+            hashes.resize(nbr_of_pages * hashWords);
+            if (!readAll(hfd, (uint8_t*)hashes.data(),
+                         hashes.size() * sizeof(uint64_t), 0))
+                hashes.clear();
+        }
+        if (hfd >= 0)
+            close(hfd);
+
+        if (hashes.empty())
+            warn("No page hashes in checkpoint %s, the next checkpoint of "
+                 "%s will not be incremental\n", cp.cptDir, filename);
+    }
+}
+
+void
+PhysicalMemory::unserializeLayer(const StoreLayer& layer, uint8_t* pmem,
+                                 AddrRange range, uint64_t chunk_size,
+                                 uint64_t page_size)
+{
+    const uint64_t pages_per_chunk = chunk_size / page_size;
+    const uint64_t nbr_of_pages = divCeil(range.size(), page_size);
+    const uint64_t nbr_of_chunks = divCeil(range.size(), chunk_size);
+
+    string filepath = layer.dir + layer.filename;
+
+    if (layer.image) {
+        unserializeImage(filepath, pmem, range);
+        return;
+    }
+
+    fatal_if(layer.chunkOffsets.size() != nbr_of_chunks ||
+             layer.chunkSizes.size() != nbr_of_chunks,
+             "Physical memory checkpoint file '%s' has %d chunks, "
+             "expected %d\n", filepath, layer.chunkSizes.size(),
+             nbr_of_chunks);
+
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    // Uncompressed pages are mapped from the file rather than read, so
+    // that they are only brought in when touched. This needs the file
+    // to be laid out for the page size of this host. Every run of
+    // pages is a mapping of its own, and a fragmented checkpoint can
+    // need more of them than the host allows (vm.max_map_count on
+    // Linux). Once a mapping fails, the rest of the pages are read.
+    bool map_pages = !layer.compressed &&
+        page_size == (uint64_t)sysconf(_SC_PAGESIZE);
+    bool map_failed = false;
+
+    vector<uint8_t> failed(nbr_of_chunks, 0);
+
+    auto restore = [&](uint64_t c) {
+        const uint64_t size = layer.chunkSizes[c];
+        if (!size)
+            return;
+
+        const uint64_t offset = layer.chunkOffsets[c];
+        const uint64_t first = c * pages_per_chunk;
+        const uint64_t num = min(pages_per_chunk, nbr_of_pages - first);
+        const uint64_t map_size = divCeil(num, 8);
+
+        if (layer.compressed) {
+            vector<uint8_t> stored(size);
+            uLongf raw_size = map_size + num * page_size;
+            vector<uint8_t> raw(raw_size);
+            if (!readAll(fd, stored.data(), size, offset) ||
+                uncompress(raw.data(), &raw_size,
+                           stored.data(), size) != Z_OK ||
+                raw_size < map_size) {
+                failed[c] = 1;
+                return;
+            }
+
+            const uint8_t* src = raw.data() + map_size;
+            const uint8_t* end = raw.data() + raw_size;
+            for (uint64_t p = 0; p < num; ++p) {
+                if (!testBit(raw, p))
+                    continue;
+                if (src + page_size > end) {
+                    failed[c] = 1;
+                    return;
+                }
+                memcpy(pmem + (first + p) * page_size, src, page_size);
+                src += page_size;
+            }
+            return;
+        }
+
+        vector<uint8_t> map(map_size);
+        if (!readAll(fd, map.data(), map_size, offset)) {
+            failed[c] = 1;
+            return;
+        }
+
+        uint64_t file_offset = offset + roundUp(map_size, page_size);
+        for (uint64_t p = 0; p < num; ) {
+            uint64_t q = p;
+            while (q < num && testBit(map, q))
+                ++q;
+
+            uint64_t len = (q - p) * page_size;
+            if (len) {
+                uint8_t* dst = pmem + (first + p) * page_size;
+                if (map_pages &&
+                    mmap(dst, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_FIXED, fd,
+                         file_offset) == MAP_FAILED) {
+                    // the store is left as it was, and while mapping
+                    // there is a single thread restoring chunks
+                    map_pages = false;
+                    map_failed = true;
+                }
+                if (!map_pages && !readAll(fd, dst, len, file_offset)) {
+                    failed[c] = 1;
+                    return;
+                }
+                file_offset += len;
+            }
+            p = max(q, p + 1);
+        }
+    };
+
+    parallelFor(map_pages ? 1 : cptThreads, nbr_of_chunks, restore);
+
+    close(fd);
+
+    if (map_failed)
+        warn("Could not map all pages of physical memory checkpoint file "
+             "'%s', read the remaining ones instead\n", filepath);
+
+    for (uint64_t c = 0; c < nbr_of_chunks; ++c)
+        if (failed[c])
+            fatal("Failed to restore chunk %d of physical memory "
+                  "checkpoint file '%s'\n", c, filepath);
+}
+
+void
+PhysicalMemory::unserializeImage(const string& filepath, uint8_t* pmem,
+                                 AddrRange range)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    struct stat st;
+    if (fstat(fd, &st) || (uint64_t)st.st_size < range.size())
+        fatal("Physical memory image '%s' is smaller than its range %s\n",
+              filepath, range.to_string());
+
+    // Replace the anonymous backing store with a private mapping of
+    // the image. Pages are read on demand and copied on write, and as
+    // any other private mapping they are shared copy-on-write with
+    // children of a fork().
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+
+    if (mmap(pmem, range.size(), PROT_READ | PROT_WRITE, map_flags,
+             fd, 0) == MAP_FAILED) {
+        perror("mmap");
+        fatal("Could not map physical memory image '%s'\n", filepath);
+    }
+
+    close(fd);
+}
+
+void
+PhysicalMemory::unserializeStoreStream(const string& filepath,
+                                       uint8_t* pmem, AddrRange range)
+{
+    const uint32_t chunk_size = 16384;
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -446,5 +1148,5 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
 }
@@ -92,6 +92,66 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<std::pair<AddrRange, uint8_t*>> backingStore;
 
+    // Size of the independently stored chunks of the checkpoints
+    const uint64_t cptChunkSize;
+
+    // Number of threads (de)compressing the chunks, 0 for one per
+    // host core
+    const unsigned cptThreads;
+
+    // Compress the checkpoint chunks, uncompressed chunks are mapped
+    // lazily on restore
+    const bool cptCompress;
+
+    // Only store the pages changed since the last checkpoint taken or
+    // restored
+    const bool cptIncremental;
+
+    // Store full checkpoints as plain images of the stores that are
+    // mapped copy-on-write on restore
+    const bool cptImage;
+
+    /**
+     * A checkpoint of a backing store is a stack of layers, each
+     * layer being a store file holding the pages that changed since
+     * the layer below it. A full checkpoint has a single layer,
+     * incremental checkpoints add a layer on top of the ones of their
+     * base checkpoint.
+     */
+    struct StoreLayer
+    {
+        // Directory of the checkpoint holding the layer, ending in '/'
+        std::string dir;
+        std::string filename;
+        bool compressed;
+        // The layer is a plain image of the store rather than chunks
+        bool image;
+        // Position and size of each chunk in the file, the size of
+        // chunks without any stored page is zero
+        std::vector<uint64_t> chunkOffsets;
+        std::vector<uint64_t> chunkSizes;
+    };
+
+    // Layers of the last checkpoint taken or restored, per store
+    mutable std::vector<std::vector<StoreLayer>> storeLayers;
+
+    // Hash of every page at the time of the last checkpoint taken or
+    // restored, used to find the pages changed since then, per store.
+    // Every hash is several words long, see hashPage().
+    mutable std::vector<std::vector<uint64_t>> pageHashes;
+
+    // Indices of the backing stores of memories in the global address
+    // map, i.e. the stores the backdoor can hand out
+    std::vector<size_t> mappedStores;
+
+    // Can functional accesses use the backdoor, i.e. is the memory
+    // guaranteed to hold the latest data
+    bool backdoorEnabled;
+
+    // Incremented whenever host pointers handed out may have become
+    // invalid
+    uint64_t hostGeneration;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -109,6 +169,29 @@ class PhysicalMemory : public Serializable
     void createBackingStore(AddrRange range,
                             const std::vector<AbstractMemory*>& _memories);
 
+    /**
+     * Restore a backing store from a checkpoint made of a single
+     * gzip stream, as written before checkpoints were split in
+     * chunks.
+     */
+    void unserializeStoreStream(const std::string &filepath,
+                                uint8_t* pmem, AddrRange range);
+
+    /**
+     * Map an image of a backing store over it, copy-on-write.
+     */
+    void unserializeImage(const std::string &filepath, uint8_t* pmem,
+                          AddrRange range);
+
+    /**
+     * Restore the pages stored in one layer of a backing store
+     * checkpoint, mapping them from the file if the layer is not
+     * compressed.
+     */
+    void unserializeLayer(const StoreLayer &layer, uint8_t* pmem,
+                          AddrRange range, uint64_t chunk_size,
+                          uint64_t page_size);
+
   public:
 
     /**
@@ -116,7 +199,10 @@ class PhysicalMemory : public Serializable
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   uint64_t cpt_chunk_size, unsigned cpt_threads,
+                   bool cpt_compress, bool cpt_incremental,
+                   bool cpt_image);
 
     /**
      * Unmap all the backing store we have used.
@@ -170,6 +256,49 @@ class PhysicalMemory : public Serializable
     std::vector<std::pair<AddrRange, uint8_t*>> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Get a host pointer to a range of physical addresses in the
+     * global address map. The range is accessed directly in the
+     * backing store, bypassing the memory system altogether, and is
+     * only guaranteed to hold the latest data if there is nothing
+     * else in the memory system that could hold a copy, see
+     * backdoor().
+     *
+     * @param addr Start of the range
+     * @param size Size of the range in bytes
+     * @return Host address of the range, NULL if it is not entirely
+     *         backed by a single store
+     */
+    uint8_t* hostAddr(Addr addr, Addr size) const;
+
+    /**
+     * Get a host pointer to a range of physical addresses for a
+     * functional access. This is the same as hostAddr(), except that
+     * it fails whenever the system cannot guarantee that the memory
+     * holds the latest data, in which case the access has to go
+     * through the memory system.
+     *
+     * @param addr Start of the range
+     * @param size Size of the range in bytes
+     * @return Host address of the range, or NULL
+     */
+    uint8_t* backdoor(Addr addr, Addr size) const
+    { return backdoorEnabled ? hostAddr(addr, size) : NULL; }
+
+    /**
+     * Allow or forbid the use of the backdoor for functional
+     * accesses, see System::updateMemBackdoor().
+     */
+    void enableBackdoor(bool enable) { backdoorEnabled = enable; }
+
+    /**
+     * Get the generation of the host mappings of the backing
+     * store. Pointers returned by hostAddr() and backdoor() must not
+     * be kept across a change of generation, which happens e.g. when
+     * a checkpoint is mapped over the memory.
+     */
+    uint64_t getHostGeneration() const { return hostGeneration; }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -200,7 +329,10 @@ class PhysicalMemory : public Serializable
     void serialize(CheckpointOut &cp) const override;
 
     /**
-     * Serialize a specific store.
+     * Serialize a specific store. The store is split in chunks that
+     * are compressed in parallel, all-zero pages are left out and,
+     * for incremental checkpoints, so are the pages that did not
+     * change since the last checkpoint.
      *
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
@@ -217,7 +349,8 @@ class PhysicalMemory : public Serializable
     void unserialize(CheckpointIn &cp) override;
 
     /**
-     * Unserialize a specific backing store, identified by a section.
+     * Unserialize a specific backing store, identified by a section,
+     * applying all the layers of an incremental checkpoint in order.
      */
     void unserializeStore(CheckpointIn &cp);
 
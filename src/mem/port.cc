@@ -49,6 +49,7 @@
 #include "base/trace.hh"
 #include "mem/mem_object.hh"
 #include "mem/port.hh"
+#include "sim/core.hh"
 
 Port::Port(const std::string &_name, MemObject& _owner, PortID _id)
     : portName(_name), id(_id), owner(_owner)
@@ -182,6 +183,19 @@ MasterPort::sendTimingReq(PacketPtr pkt)
     return _slavePort->recvTimingReq(pkt);
 }
 
+unsigned
+MasterPort::sendTimingReqBatch(const PacketBatch& batch)
+{
+    assert(!batch.empty() && batch.front().when <= curTick());
+    return _slavePort->recvTimingReqBatch(batch);
+}
+
+bool
+MasterPort::peerAcceptsTimingReqBatch() const
+{
+    return _slavePort->acceptsTimingReqBatch();
+}
+
 bool
 MasterPort::sendTimingSnoopResp(PacketPtr pkt)
 {
@@ -271,3 +285,17 @@ SlavePort::sendRetrySnoopResp()
 {
     _masterPort->recvRetrySnoopResp();
 }
+
+unsigned
+SlavePort::recvTimingReqBatch(const PacketBatch& batch)
+{
+    unsigned accepted = 0;
+    for (const auto& p : batch) {
+        // leave anything that is not yet due to the master, and stop
+        // at the first refusal as the master now waits for a retry
+        if (p.when > curTick() || !recvTimingReq(p.pkt))
+            break;
+        ++accepted;
+    }
+    return accepted;
+}
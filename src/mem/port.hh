@@ -50,11 +50,31 @@
 #ifndef __MEM_PORT_HH__
 #define __MEM_PORT_HH__
 
+#include <vector>
+
 #include "base/addr_range.hh"
 #include "mem/packet.hh"
 
 class MemObject;
 
+/**
+ * A timing packet handed over as part of a batch, along with the tick
+ * at which the sender would otherwise have sent it on its own.
+ */
+struct TimedPacket
+{
+    PacketPtr pkt;
+    Tick when;
+
+    TimedPacket(PacketPtr _pkt, Tick _when) : pkt(_pkt), when(_when) { }
+};
+
+/**
+ * A burst of timing packets, sorted by the tick at which they are
+ * due, with the first one due no later than the current tick.
+ */
+typedef std::vector<TimedPacket> PacketBatch;
+
 /**
  * Ports are used to interface memory objects to each other. A port is
  * either a master or a slave and the connected peer is always of the
@@ -223,6 +243,43 @@ class MasterPort : public BaseMasterPort
     */
     bool sendTimingReq(PacketPtr pkt);
 
+    /**
+     * Attempt to send a burst of timing requests to the slave port in
+     * a single call. The slave accepts the packets in order and stops
+     * either at the first one it refuses, or at the first one that is
+     * not yet due and that it is not prepared to take ahead of
+     * time. Only a refusal of a packet that is due obliges the slave
+     * to send a recvReqRetry, any packet that is left for later has
+     * to be sent again by the master when it is due.
+     *
+     * Slave ports that do not know about batches get the packets that
+     * are due one by one through recvTimingReq, and thus see exactly
+     * the same sequence of calls as if the master never batched.
+     *
+     * A slave that takes packets ahead of time treats each of them as
+     * arriving at the tick it is due, and does not make it visible,
+     * e.g. to functional accesses, any earlier. It does, however,
+     * hold on to its resources from the start of the batch, so that
+     * packets from other masters that would have fitted in between
+     * the packets of the batch now wait for it to finish. Batching
+     * can thus change the timing of other masters, and masters only
+     * send batches when explicitly configured to do so.
+     *
+     * @param batch Packets to send, the first one being due now.
+     *
+     * @return The number of packets accepted, from the start.
+     */
+    unsigned sendTimingReqBatch(const PacketBatch& batch);
+
+    /**
+     * Determine if the slave port is able to take timing requests
+     * ahead of time as part of a batch. A master can use this to
+     * avoid assembling batches that would only be split up again.
+     *
+     * @return true if the peer handles batches itself
+     */
+    bool peerAcceptsTimingReqBatch() const;
+
     /**
      * Attempt to send a timing snoop response packet to the slave
      * port by calling its corresponding receive function. If the send
@@ -422,6 +479,17 @@ class SlavePort : public BaseSlavePort
      */
     virtual AddrRangeList getAddrRanges() const = 0;
 
+    /**
+     * Determine if this slave port takes timing requests ahead of
+     * time as part of a batch. The default implementation returns
+     * false, and any slave port overriding recvTimingReqBatch to
+     * accept packets that are not yet due should also override this
+     * function.
+     *
+     * @return true if the port handles batches itself
+     */
+    virtual bool acceptsTimingReqBatch() const { return false; }
+
   protected:
 
     /**
@@ -451,6 +519,18 @@ class SlavePort : public BaseSlavePort
      */
     virtual bool recvTimingReq(PacketPtr pkt) = 0;
 
+    /**
+     * Receive a burst of timing requests from the master port. The
+     * default implementation adapts the batch to recvTimingReq by
+     * passing on the packets that are due, one by one, until one is
+     * refused or the next one is not yet due.
+     *
+     * @param batch Packets received, the first one being due now.
+     *
+     * @return The number of packets accepted, from the start.
+     */
+    virtual unsigned recvTimingReqBatch(const PacketBatch& batch);
+
     /**
      * Receive a timing snoop response from the master port.
      */
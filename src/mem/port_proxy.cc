@@ -38,11 +38,18 @@
  */
 
 #include "base/chunk_generator.hh"
+#include "mem/physical.hh"
 #include "mem/port_proxy.hh"
 
 void
 PortProxy::readBlob(Addr addr, uint8_t *p, int size) const
 {
+    const uint8_t *host = _physmem ? _physmem->backdoor(addr, size) : NULL;
+    if (host) {
+        std::memcpy(p, host, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
         Request req(gen.addr(), gen.size(), 0, Request::funcMasterId);
@@ -56,6 +63,12 @@ PortProxy::readBlob(Addr addr, uint8_t *p, int size) const
 void
 PortProxy::writeBlob(Addr addr, const uint8_t *p, int size) const
 {
+    uint8_t *host = _physmem ? _physmem->backdoor(addr, size) : NULL;
+    if (host) {
+        std::memcpy(host, p, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
         Request req(gen.addr(), gen.size(), 0, Request::funcMasterId);
@@ -69,6 +82,12 @@ PortProxy::writeBlob(Addr addr, const uint8_t *p, int size) const
 void
 PortProxy::memsetBlob(Addr addr, uint8_t v, int size) const
 {
+    uint8_t *host = _physmem ? _physmem->backdoor(addr, size) : NULL;
+    if (host) {
+        std::memset(host, v, size);
+        return;
+    }
+
     // quick and dirty...
     uint8_t *buf = new uint8_t[size];
 
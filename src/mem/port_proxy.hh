@@ -67,6 +67,8 @@
 #include "mem/port.hh"
 #include "sim/byteswap.hh"
 
+class PhysicalMemory;
+
 /**
  * This object is a proxy for a structural port, to be used for debug
  * accesses.
@@ -78,6 +80,11 @@
  *
  * The addresses are interpreted as physical addresses.
  *
+ * If given the physical memory of the system, accesses to memory are
+ * turned into plain copies from and to its backing store whenever
+ * the memory holds the latest data (see PhysicalMemory::backdoor()),
+ * rather than being split in packets sent through the port.
+ *
  * @sa SETranslatingProxy
  * @sa FSTranslatingProxy
  */
@@ -91,9 +98,13 @@ class PortProxy
     /** Granularity of any transactions issued through this proxy. */
     const unsigned int _cacheLineSize;
 
+    /** Memory accessed directly when possible, NULL if none. */
+    const PhysicalMemory *_physmem;
+
   public:
-    PortProxy(MasterPort &port, unsigned int cacheLineSize) :
-        _port(port), _cacheLineSize(cacheLineSize) { }
+    PortProxy(MasterPort &port, unsigned int cacheLineSize,
+              const PhysicalMemory *physmem = NULL) :
+        _port(port), _cacheLineSize(cacheLineSize), _physmem(physmem) { }
     virtual ~PortProxy() { }
 
     /**
@@ -36,18 +36,38 @@ Consumer::scheduleEvent(Cycles timeDelta)
     scheduleEventAbsolute(em->clockEdge(timeDelta));
 }
 
+Consumer::~Consumer()
+{
+    for (auto evt : m_events) {
+        if (evt->scheduled())
+            em->deschedule(evt);
+        delete evt;
+    }
+}
+
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
     if (!alreadyScheduled(evt_time)) {
-        // This wakeup is not redundant
-        ConsumerEvent *evt = new ConsumerEvent(this);
+        // This wakeup is not redundant. Every wakeup still gets an
+        // event of its own, scheduled right now, so that wakeups are
+        // ordered against other events exactly as if a new event had
+        // been allocated; only the event objects are recycled.
+        ConsumerEvent *evt;
+        if (m_free_events.empty()) {
+            evt = new ConsumerEvent(this);
+            m_events.push_back(evt);
+        } else {
+            evt = m_free_events.back();
+            m_free_events.pop_back();
+        }
         em->schedule(evt, evt_time);
         insertScheduledWakeupTime(evt_time);
     }
 
     Tick t = em->clockEdge();
-    set<Tick>::iterator bit = m_scheduled_wakeups.begin();
-    set<Tick>::iterator eit = m_scheduled_wakeups.lower_bound(t);
-    m_scheduled_wakeups.erase(bit,eit);
+    m_scheduled_wakeups.erase(m_scheduled_wakeups.begin(),
+                              std::lower_bound(m_scheduled_wakeups.begin(),
+                                               m_scheduled_wakeups.end(),
+                                               t));
 }
@@ -35,8 +35,9 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <algorithm>
 #include <iostream>
-#include <set>
+#include <vector>
 
 #include "sim/clocked_object.hh"
 
@@ -48,9 +49,7 @@ class Consumer
     {
     }
 
-    virtual
-    ~Consumer()
-    { }
+    virtual ~Consumer();
 
     virtual void wakeup() = 0;
     virtual void print(std::ostream& out) const = 0;
@@ -59,37 +58,65 @@ class Consumer
     bool
     alreadyScheduled(Tick time)
     {
-        return m_scheduled_wakeups.find(time) != m_scheduled_wakeups.end();
+        return std::binary_search(m_scheduled_wakeups.begin(),
+                                  m_scheduled_wakeups.end(), time);
     }
 
     void
     insertScheduledWakeupTime(Tick time)
     {
-        m_scheduled_wakeups.insert(time);
+        std::vector<Tick>::iterator it =
+            std::lower_bound(m_scheduled_wakeups.begin(),
+                             m_scheduled_wakeups.end(), time);
+        if (it == m_scheduled_wakeups.end() || *it != time)
+            m_scheduled_wakeups.insert(it, time);
     }
 
     void scheduleEventAbsolute(Tick timeAbs);
 
+    /** Event queue the wakeups of this consumer are serviced on. */
+    EventQueue *consumerQueue() const { return em->eventQueue(); }
+
   protected:
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_scheduled_wakeups;
-    ClockedObject *em;
-
     class ConsumerEvent : public Event
     {
       public:
           ConsumerEvent(Consumer* _consumer)
-              : Event(Default_Pri, AutoDelete), m_consumer_ptr(_consumer)
+              : Event(Default_Pri), m_consumer_ptr(_consumer)
           {
           }
 
-          void process() { m_consumer_ptr->wakeup(); }
+          void
+          process()
+          {
+              // The event may be reused by the wakeup it triggers
+              m_consumer_ptr->m_free_events.push_back(this);
+              m_consumer_ptr->wakeup();
+          }
 
       private:
           Consumer* m_consumer_ptr;
     };
+
+    /**
+     * Times of the pending wakeups in ascending order. A consumer only
+     * has a handful of wakeups in flight, so a sorted vector beats a
+     * tree. Times in the past are pruned when a new wakeup is
+     * scheduled, which means a wakeup stays scheduled for the whole
+     * tick it is serviced in.
+     */
+    std::vector<Tick> m_scheduled_wakeups;
+
+    /** All wakeup events owned by this consumer. */
+    std::vector<ConsumerEvent *> m_events;
+
+    /** Wakeup events that are not scheduled and can be reused. */
+    std::vector<ConsumerEvent *> m_free_events;
+
+    ClockedObject *em;
 };
 
 inline std::ostream&
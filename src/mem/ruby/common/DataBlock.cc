@@ -27,33 +27,19 @@
  */
 
 #include "mem/ruby/common/DataBlock.hh"
+
+#include "base/misc.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
-DataBlock::DataBlock(const DataBlock &cp)
-{
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
-}
+int DataBlock::m_block_size_bytes = 0;
 
 void
-DataBlock::alloc()
+DataBlock::setBlockSizeBytes(int size)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
-}
-
-void
-DataBlock::clear()
-{
-    memset(m_data, 0, RubySystem::getBlockSizeBytes());
-}
-
-bool
-DataBlock::equal(const DataBlock& obj) const
-{
-    return !memcmp(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    fatal_if(size > maxBlockSizeBytes,
+             "Ruby block size %d is larger than the %d bytes a DataBlock "
+             "can hold\n", size, maxBlockSizeBytes);
+    m_block_size_bytes = size;
 }
 
 void
@@ -83,10 +69,3 @@ DataBlock::setData(const uint8_t *data, int offset, int len)
     assert(offset + len <= RubySystem::getBlockSizeBytes());
     memcpy(&m_data[offset], data, len);
 }
-
-DataBlock &
-DataBlock::operator=(const DataBlock & obj)
-{
-    memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
-    return *this;
-}
@@ -32,28 +32,56 @@
 #include <inttypes.h>
 
 #include <cassert>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/**
+ * A cache line worth of data. The line lives inline in the object so
+ * that creating, copying and destroying blocks (once per message,
+ * TBE and cache entry) never goes to the heap. The storage is sized
+ * for the largest supported block size and aligned for vector
+ * accesses; only the first RubySystem::getBlockSizeBytes() bytes are
+ * ever used. Whole-line copies, comparisons and clears are done with
+ * SSE2/AVX kernels when the host supports them, with a plain
+ * memcpy/memcmp/memset fallback.
+ */
 class DataBlock
 {
   public:
+    /** Largest block size that fits in the inline storage. */
+    static const int maxBlockSizeBytes = 128;
+
     DataBlock()
     {
-        alloc();
+        clear();
     }
 
-    DataBlock(const DataBlock &cp);
-
-    ~DataBlock()
+    DataBlock(const DataBlock &cp)
     {
-        if (m_alloc)
-            delete [] m_data;
+        copyLine(m_data, cp.m_data, blockSize());
     }
 
-    DataBlock& operator=(const DataBlock& obj);
+    DataBlock &
+    operator=(const DataBlock &obj)
+    {
+        if (this != &obj)
+            copyLine(m_data, obj.m_data, blockSize());
+        return *this;
+    }
 
-    void assign(uint8_t *data);
+    /**
+     * Set the block size used by all blocks. Called by RubySystem,
+     * which owns the block size, before any block is created.
+     */
+    static void setBlockSizeBytes(int size);
 
     void clear();
     uint8_t getByte(int whichByte) const;
@@ -65,21 +93,22 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
-    void alloc();
-    uint8_t *m_data;
-    bool m_alloc;
-};
+    static int blockSize() { return m_block_size_bytes; }
 
-inline void
-DataBlock::assign(uint8_t *data)
-{
-    assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
-    m_data = data;
-    m_alloc = false;
-}
+    /** Copy a line of size bytes; both pointers are vector aligned. */
+    static void copyLine(uint8_t *dst, const uint8_t *src, int size);
+
+    /** Compare two lines of size bytes for equality. */
+    static bool equalLine(const uint8_t *a, const uint8_t *b, int size);
+
+    /** Zero a line of size bytes. */
+    static void clearLine(uint8_t *dst, int size);
+
+    /** Mirror of RubySystem::getBlockSizeBytes() for inlining. */
+    static int m_block_size_bytes;
+
+    alignas(16) uint8_t m_data[maxBlockSizeBytes];
+};
 
 inline uint8_t
 DataBlock::getByte(int whichByte) const
@@ -99,6 +128,85 @@ DataBlock::copyPartial(const DataBlock & dblk, int offset, int len)
     setData(&dblk.m_data[offset], offset, len);
 }
 
+inline void
+DataBlock::clear()
+{
+    clearLine(m_data, blockSize());
+}
+
+inline bool
+DataBlock::equal(const DataBlock& obj) const
+{
+    return equalLine(m_data, obj.m_data, blockSize());
+}
+
+/*
+ * The kernels below work on whole 16 byte (SSE2) or 32 byte (AVX)
+ * vectors, which is fine since block sizes are powers of two of at
+ * least that size in any practical configuration; smaller blocks take
+ * the scalar path. Vectors are only guaranteed 16 byte alignment (the
+ * alignment of heap allocations), so the AVX loads and stores are
+ * unaligned ones.
+ */
+
+inline void
+DataBlock::copyLine(uint8_t *dst, const uint8_t *src, int size)
+{
+#if defined(__AVX__)
+    if (size >= 32) {
+        for (int i = 0; i < size; i += 32) {
+            _mm256_storeu_si256((__m256i *)(dst + i),
+                _mm256_loadu_si256((const __m256i *)(src + i)));
+        }
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    if (size >= 16) {
+        for (int i = 0; i < size; i += 16) {
+            _mm_store_si128((__m128i *)(dst + i),
+                _mm_load_si128((const __m128i *)(src + i)));
+        }
+        return;
+    }
+#endif
+    memcpy(dst, src, size);
+}
+
+inline bool
+DataBlock::equalLine(const uint8_t *a, const uint8_t *b, int size)
+{
+#if defined(__SSE2__)
+    if (size >= 16) {
+        // Accumulate the differences of the whole line and test once,
+        // a line is short enough that an early exit does not pay off.
+        __m128i diff = _mm_setzero_si128();
+        for (int i = 0; i < size; i += 16) {
+            diff = _mm_or_si128(diff, _mm_xor_si128(
+                _mm_load_si128((const __m128i *)(a + i)),
+                _mm_load_si128((const __m128i *)(b + i))));
+        }
+        return _mm_movemask_epi8(
+            _mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xffff;
+    }
+#endif
+    return !memcmp(a, b, size);
+}
+
+inline void
+DataBlock::clearLine(uint8_t *dst, int size)
+{
+#if defined(__SSE2__)
+    if (size >= 16) {
+        const __m128i zero = _mm_setzero_si128();
+        for (int i = 0; i < size; i += 16)
+            _mm_store_si128((__m128i *)(dst + i), zero);
+        return;
+    }
+#endif
+    memset(dst, 0, size);
+}
+
 inline std::ostream&
 operator<<(std::ostream& out, const DataBlock& obj)
 {
@@ -32,23 +32,7 @@
 
 NetDest::NetDest()
 {
-  resize();
-}
-
-void
-NetDest::add(MachineID newElement)
-{
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
-}
-
-void
-NetDest::addNetDest(const NetDest& netDest)
-{
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
-    }
+    clear();
 }
 
 void
@@ -57,29 +41,15 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
-}
-
-void
-NetDest::remove(MachineID oldElement)
-{
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
-}
-
-void
-NetDest::removeNetDest(const NetDest& netDest)
-{
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    int base = MachineType_base_level(machine) * wordsPerType;
+    for (int i = 0; i < wordsPerType; i++) {
+        m_bits[base + i] = 0;
     }
-}
-
-void
-NetDest::clear()
-{
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
+    for (NodeID j = 0; j < set.getSize(); j++) {
+        if (set.isElement(j)) {
+            MachineID mach = {machine, j};
+            add(mach);
+        }
     }
 }
 
@@ -107,10 +77,14 @@ NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
     dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
+    for (int i = 0; i < MachineType_NUM; i++) {
+        for (int j = 0; j < wordsPerType; j++) {
+            uint64_t word = m_bits[i * wordsPerType + j];
+            while (word) {
+                int bit = findLsbSet(word);
+                word &= word - 1;
+                int id = MachineType_base_number((MachineType)i) +
+                    j * 64 + bit;
                 dest.push_back((NodeID)id);
             }
         }
@@ -118,32 +92,22 @@ NetDest::getAllDest()
     return dest;
 }
 
-int
-NetDest::count() const
-{
-    int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
-    }
-    return counter;
-}
-
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i]) {
+            MachineID mach = {MachineType_from_base_level(i / wordsPerType),
+                              (NodeID)((i % wordsPerType) * 64 +
+                                       findLsbSet(m_bits[i]))};
+            return mach;
         }
     }
     panic("No smallest element of an empty set.");
@@ -152,10 +116,11 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
+    int base = MachineType_base_level(machine) * wordsPerType;
+    for (int i = 0; i < wordsPerType; i++) {
+        if (m_bits[base + i]) {
+            MachineID mach = {machine,
+                              (NodeID)(i * 64 + findLsbSet(m_bits[base + i]))};
             return mach;
         }
     }
@@ -167,114 +132,29 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
-            return false;
+    for (int i = 0; i < MachineType_NUM; i++) {
+        int counter = 0;
+        for (int j = 0; j < wordsPerType; j++) {
+            counter += popCount(m_bits[i * wordsPerType + j]);
         }
-    }
-    return true;
-}
-
-// Returns true iff no bits are set
-bool
-NetDest::isEmpty() const
-{
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+        if (counter != MachineType_base_count((MachineType)i)) {
             return false;
         }
     }
     return true;
 }
 
-// returns the logical OR of "this" set and orNetDest
-NetDest
-NetDest::OR(const NetDest& orNetDest) const
-{
-    assert(m_bits.size() == orNetDest.getSize());
-    NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
-    }
-    return result;
-}
-
-// returns the logical AND of "this" set and andNetDest
-NetDest
-NetDest::AND(const NetDest& andNetDest) const
-{
-    assert(m_bits.size() == andNetDest.getSize());
-    NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
-    }
-    return result;
-}
-
-// Returns true if the intersection of the two sets is non-empty
-bool
-NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
-{
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool
-NetDest::isSuperset(const NetDest& test) const
-{
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool
-NetDest::isElement(MachineID element) const
-{
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
-}
-
-void
-NetDest::resize()
-{
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
-}
-
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << getSize() << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (int i = 0; i < MachineType_NUM; i++) {
+        for (int j = 0; j < MachineType_base_count((MachineType)i); j++) {
+            MachineID mach = {(MachineType)i, (NodeID)j};
+            out << isElement(mach) << " ";
         }
         out << " - ";
     }
     out << "]";
 }
-
-bool
-NetDest::isEqual(const NetDest& n) const
-{
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
-}
@@ -29,9 +29,11 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <functional>
 #include <iostream>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/ruby/common/Set.hh"
 #include "mem/ruby/common/MachineID.hh"
 
@@ -84,30 +86,186 @@ class NetDest
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
-    void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
 
+    // hash of the destination bits, for use as a map key
+    size_t hash() const;
+
     void print(std::ostream& out) const;
 
   private:
+    // Each machine type owns wordsPerType consecutive words of m_bits,
+    // enough for the NUMBER_BITS_PER_SET machines a Set can hold, so
+    // that the operations on whole NetDests are a few word operations
+    // and a NetDest needs no storage of its own on the heap.
+    static const int wordsPerType = (NUMBER_BITS_PER_SET + 63) / 64;
+    static const int numWords = MachineType_NUM * wordsPerType;
+
     // returns a value >= MachineType_base_level("this machine")
     // and < MachineType_base_level("next highest machine")
     int
     vecIndex(MachineID m) const
     {
         int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
+        assert(vec_index < MachineType_NUM);
         return vec_index;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    // word and bit of machine m in m_bits
+    int
+    wordIndex(MachineID m) const
+    {
+        assert(m.num < NUMBER_BITS_PER_SET);
+        return vecIndex(m) * wordsPerType + m.num / 64;
+    }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    static uint64_t bitMask(MachineID m) { return 1ULL << (m.num % 64); }
+
+    uint64_t m_bits[numWords];
 };
 
+inline void
+NetDest::add(MachineID newElement)
+{
+    assert((int)newElement.num < MachineType_base_count(newElement.type));
+    m_bits[wordIndex(newElement)] |= bitMask(newElement);
+}
+
+inline void
+NetDest::addNetDest(const NetDest& netDest)
+{
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
+    }
+}
+
+inline void
+NetDest::remove(MachineID oldElement)
+{
+    m_bits[wordIndex(oldElement)] &= ~bitMask(oldElement);
+}
+
+inline void
+NetDest::removeNetDest(const NetDest& netDest)
+{
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
+    }
+}
+
+inline void
+NetDest::clear()
+{
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] = 0;
+    }
+}
+
+inline int
+NetDest::count() const
+{
+    int counter = 0;
+    for (int i = 0; i < numWords; i++) {
+        counter += popCount(m_bits[i]);
+    }
+    return counter;
+}
+
+inline bool
+NetDest::isEqual(const NetDest& n) const
+{
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i] != n.m_bits[i])
+            return false;
+    }
+    return true;
+}
+
+// returns the logical OR of "this" set and orNetDest
+inline NetDest
+NetDest::OR(const NetDest& orNetDest) const
+{
+    NetDest result;
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
+    }
+    return result;
+}
+
+// returns the logical AND of "this" set and andNetDest
+inline NetDest
+NetDest::AND(const NetDest& andNetDest) const
+{
+    NetDest result;
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
+    }
+    return result;
+}
+
+// Returns true if the intersection of the two sets is non-empty
+inline bool
+NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
+{
+    uint64_t any = 0;
+    for (int i = 0; i < numWords; i++) {
+        any |= m_bits[i] & other_netDest.m_bits[i];
+    }
+    return any != 0;
+}
+
+inline bool
+NetDest::intersectionIsEmpty(const NetDest& other_netDest) const
+{
+    return !intersectionIsNotEmpty(other_netDest);
+}
+
+inline bool
+NetDest::isSuperset(const NetDest& test) const
+{
+    uint64_t missing = 0;
+    for (int i = 0; i < numWords; i++) {
+        missing |= test.m_bits[i] & ~m_bits[i];
+    }
+    return missing == 0;
+}
+
+inline bool
+NetDest::isElement(MachineID element) const
+{
+    return m_bits[wordIndex(element)] & bitMask(element);
+}
+
+// Returns true iff no bits are set
+inline bool
+NetDest::isEmpty() const
+{
+    uint64_t any = 0;
+    for (int i = 0; i < numWords; i++) {
+        any |= m_bits[i];
+    }
+    return any == 0;
+}
+
+inline size_t
+NetDest::hash() const
+{
+    size_t h = 0;
+    for (int i = 0; i < numWords; i++) {
+        h = h * 0x9e3779b97f4a7c15ULL + m_bits[i];
+    }
+    return h ^ (h >> 29);
+}
+
+inline bool
+operator==(const NetDest& a, const NetDest& b)
+{
+    return a.isEqual(b);
+}
+
 inline std::ostream&
 operator<<(std::ostream& out, const NetDest& obj)
 {
@@ -116,4 +274,12 @@ operator<<(std::ostream& out, const NetDest& obj)
     return out;
 }
 
+namespace std {
+template <>
+struct hash<NetDest>
+{
+    size_t operator()(const NetDest& d) const { return d.hash(); }
+};
+}
+
 #endif // __MEM_RUBY_COMMON_NETDEST_HH__
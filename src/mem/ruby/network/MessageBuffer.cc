@@ -26,6 +26,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -53,10 +54,15 @@ MessageBuffer::MessageBuffer(const Params *p)
     m_msgs_this_cycle = 0;
     m_not_avail_count = 0;
     m_priority_rank = 0;
+    m_ready_size = 0;
+    m_stall_size = 0;
 
     m_stall_msg_map.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
+    m_cross_queue = false;
+    m_send_counter = 0;
+    m_send_last_arrival_time = 0;
 }
 
 unsigned int
@@ -64,7 +70,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = m_ready_size;
     }
 
     return m_size_last_time_size_checked;
@@ -87,7 +93,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap size is correct
-        current_size = m_prio_heap.size();
+        current_size = m_ready_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
             // no enqueues this cycle - m_size_at_cycle_start is correct
@@ -105,7 +111,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
     } else {
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
-                n, current_size, m_prio_heap.size(), m_max_size);
+                n, current_size, m_ready_size, m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -115,7 +121,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = peekMsgPtr().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -137,14 +143,32 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
+    assert(m_consumer != NULL);
+
+    // Everything but the arrival time computation belongs to the
+    // consumer side, which may be running on another thread
+    EventQueue *consumer_queue = m_consumer->consumerQueue();
+    bool cross_queue = consumer_queue != curEventQueue();
+    if (cross_queue && !m_cross_queue) {
+        fatal("%s: enqueue from event queue %d to a consumer on event "
+              "queue %d, only network links can connect event queues\n",
+              name(), curEventQueue()->index(), consumer_queue->index());
+    }
+
     // record current time incase we have a pop that also adjusts my size
-    if (m_time_last_time_enqueue < current_time) {
-        m_msgs_this_cycle = 0;  // first msg this cycle
-        m_time_last_time_enqueue = current_time;
+    if (!cross_queue) {
+        if (m_time_last_time_enqueue < current_time) {
+            m_msgs_this_cycle = 0;  // first msg this cycle
+            m_time_last_time_enqueue = current_time;
+        }
+
+        m_msgs_this_cycle++;
     }
 
-    m_msg_counter++;
-    m_msgs_this_cycle++;
+    // The arrival time of the last message is kept by the sending
+    // side, which is another thread when crossing event queues
+    Tick &last_arrival_time =
+        cross_queue ? m_send_last_arrival_time : m_last_arrival_time;
 
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
@@ -157,10 +181,10 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     } else {
         // Randomization - ignore delta
         if (m_strict_fifo) {
-            if (m_last_arrival_time < current_time) {
-                m_last_arrival_time = current_time;
+            if (last_arrival_time < current_time) {
+                last_arrival_time = current_time;
             }
-            arrival_time = m_last_arrival_time + random_time();
+            arrival_time = last_arrival_time + random_time();
         } else {
             arrival_time = current_time + random_time();
         }
@@ -169,17 +193,17 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     // Check the arrival time
     assert(arrival_time > current_time);
     if (m_strict_fifo) {
-        if (arrival_time < m_last_arrival_time) {
+        if (arrival_time < last_arrival_time) {
             panic("FIFO ordering violated: %s name: %s current time: %d "
                   "delta: %d arrival_time: %d last arrival_time: %d\n",
                   *this, name(), current_time, delta, arrival_time,
-                  m_last_arrival_time);
+                  last_arrival_time);
         }
     }
 
     // If running a cache trace, don't worry about the last arrival checks
     if (!RubySystem::getWarmupEnabled()) {
-        m_last_arrival_time = arrival_time;
+        last_arrival_time = arrival_time;
     }
 
     // compute the delay cycles and set enqueue time
@@ -191,21 +215,78 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 
     msg_ptr->updateDelayedTicks(current_time);
     msg_ptr->setLastEnqueueTime(arrival_time);
-    msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    if (cross_queue) {
+        // The message is handed over to the consumer's event queue and
+        // inserted when it arrives. Since the enqueue delay covers the
+        // lookahead of the link, this happens in a later quantum.
+        DPRINTF(RubyQueue, "Enqueue arrival_time: %lld from event queue "
+                "%d, Message: %s\n", arrival_time, curEventQueue()->index(),
+                *msg_ptr);
+        InFlightList::iterator in_flight;
+        {
+            std::lock_guard<std::mutex> lock(m_in_flight_mutex);
+            in_flight = m_in_flight.insert(m_in_flight.end(), message);
+        }
+        consumer_queue->schedule(
+            new DeliveryEvent(*this, message, ++m_send_counter, in_flight),
+            arrival_time);
+        return;
+    }
+
+    m_msg_counter++;
+    message->setMsgCounter(m_msg_counter);
+
+    insertMessage(message);
+}
+
+void
+MessageBuffer::deliverMessage(const MsgPtr &message, uint64_t counter,
+                              InFlightList::iterator in_flight)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_in_flight_mutex);
+        m_in_flight.erase(in_flight);
+    }
 
+    // Keep the sender's counter, and make messages this side stamps
+    // later, e.g., when reanalyzing stalled messages, go after it
+    message->setMsgCounter(counter);
+    m_msg_counter = std::max(m_msg_counter, counter);
+
+    insertMessage(message);
+}
+
+void
+MessageBuffer::insertMessage(const MsgPtr &message)
+{
+    // Insert the message into its arrival bucket
+    insertReady(message);
+
+    Tick arrival_time = message->getLastEnqueueTime();
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+void
+MessageBuffer::allowCrossQueue()
+{
+    // Neither can the sender look at the occupancy of the buffer, nor
+    // can the shared random number generator be used from several
+    // threads
+    fatal_if(m_max_size != 0, "%s: a message buffer of limited size "
+             "cannot connect two event queues\n", name());
+    fatal_if(RubySystem::getRandomization() && m_randomization,
+             "%s: randomized message buffers cannot connect two event "
+             "queues\n", name());
+
+    m_cross_queue = true;
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time)
 {
@@ -213,7 +294,7 @@ MessageBuffer::dequeue(Tick current_time)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -222,12 +303,11 @@ MessageBuffer::dequeue(Tick current_time)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = m_ready_size;
         m_time_last_time_pop = current_time;
     }
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    popReady();
 
     return delay;
 }
@@ -235,7 +315,8 @@ MessageBuffer::dequeue(Tick current_time)
 void
 MessageBuffer::clear()
 {
-    m_prio_heap.clear();
+    m_ready.clear();
+    m_ready_size = 0;
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -249,40 +330,98 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    MsgPtr node = peekMsgPtr();
+    popReady();
 
+    // The message keeps its counter, so it goes ahead of any younger
+    // message that arrives at the same time
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    insertReady(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::insertReady(const MsgPtr &message)
 {
-    while(!lt.empty()) {
+    Tick time = message->getLastEnqueueTime();
+    uint64_t counter = message->getMsgCounter();
+
+    // Find the bucket for the arrival time, walking from the back as
+    // new messages almost always arrive last
+    deque<ReadyBucket>::iterator bucket = m_ready.end();
+    while (bucket != m_ready.begin() && (bucket - 1)->time > time)
+        --bucket;
+
+    if (bucket == m_ready.begin() || (bucket - 1)->time != time) {
+        bucket = m_ready.insert(bucket, ReadyBucket());
+        bucket->time = time;
+        bucket->head = 0;
+        if (!m_spare_buckets.empty()) {
+            bucket->msgs.swap(m_spare_buckets.back());
+            m_spare_buckets.pop_back();
+        }
+    } else {
+        --bucket;
+    }
+
+    // Messages are normally enqueued in counter order, only recycled
+    // messages may have to go further ahead
+    vector<MsgPtr> &msgs = bucket->msgs;
+    unsigned int pos = msgs.size();
+    while (pos > bucket->head && msgs[pos - 1]->getMsgCounter() > counter)
+        --pos;
+    msgs.insert(msgs.begin() + pos, message);
+
+    m_ready_size++;
+}
+
+void
+MessageBuffer::popReady()
+{
+    assert(m_ready_size > 0);
+    ReadyBucket &bucket = m_ready.front();
+    bucket.msgs[bucket.head++].reset();
+    m_ready_size--;
+
+    if (bucket.head == bucket.msgs.size()) {
+        bucket.msgs.clear();
+        m_spare_buckets.push_back(std::move(bucket.msgs));
+        m_ready.pop_front();
+    }
+}
+
+void
+MessageBuffer::updateStallDepth()
+{
+    m_stall_queue_depth = m_stall_size;
+}
+
+void
+MessageBuffer::reanalyzeList(StallList &lt, Tick schdTick)
+{
+    for (auto &m : lt) {
         m_msg_counter++;
-        MsgPtr m = lt.front();
         m->setLastEnqueueTime(schdTick);
         m->setMsgCounter(m_msg_counter);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  greater<MsgPtr>());
+        insertReady(m);
 
         m_consumer->scheduleEventAbsolute(schdTick);
-        lt.pop_front();
     }
+
+    m_reanalyze_count += lt.size();
+    m_stall_size -= lt.size();
+    lt.clear();
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    StallMsgMapType::iterator it = m_stall_msg_map.find(addr);
+    assert(it != m_stall_msg_map.end());
 
     //
     // Put all stalled messages associated with this address back on the
@@ -290,8 +429,9 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    reanalyzeList(it->second, current_time);
+    m_stall_msg_map.erase(it);
+    updateStallDepth();
 }
 
 void
@@ -299,17 +439,25 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeAllMessages\n");
 
+    // Wake up the addresses in ascending order, the order the stalled
+    // messages were observed in when the map was sorted
+    vector<Addr> addrs;
+    addrs.reserve(m_stall_msg_map.size());
+    for (auto &stalled : m_stall_msg_map)
+        addrs.push_back(stalled.first);
+    sort(addrs.begin(), addrs.end());
+
     //
     // Put all stalled messages associated with this address back on the
     // prio heap.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        reanalyzeList(map_iter->second, current_time);
+    for (auto addr : addrs) {
+        reanalyzeList(m_stall_msg_map[addr], current_time);
     }
     m_stall_msg_map.clear();
+    updateStallDepth();
 }
 
 void
@@ -318,7 +466,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     dequeue(current_time);
 
@@ -328,6 +476,9 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // these addresses change state.
     //
     (m_stall_msg_map[addr]).push_back(message);
+    m_stall_size++;
+    m_stall_count++;
+    updateStallDepth();
 }
 
 void
@@ -338,16 +489,19 @@ MessageBuffer::print(ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    vector<MsgPtr> copy(m_prio_heap);
-    sort_heap(copy.begin(), copy.end(), greater<MsgPtr>());
+    vector<MsgPtr> copy;
+    for (auto &bucket : m_ready) {
+        copy.insert(copy.end(), bucket.msgs.begin() + bucket.head,
+                    bucket.msgs.end());
+    }
     ccprintf(out, "%s] %s", copy, name());
 }
 
 bool
 MessageBuffer::isReady(Tick current_time) const
 {
-    return ((m_prio_heap.size() > 0) &&
-        (m_prio_heap.front()->getLastEnqueueTime() <= current_time));
+    return ((m_ready_size > 0) &&
+        (m_ready.front().time <= current_time));
 }
 
 uint32_t
@@ -355,12 +509,14 @@ MessageBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    // Check the priority heap and write any messages that may
+    // Check the queued messages and write any messages that may
     // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
-        if (msg->functionalWrite(pkt)) {
-            num_functional_writes++;
+    for (auto &bucket : m_ready) {
+        for (unsigned int i = bucket.head; i < bucket.msgs.size(); ++i) {
+            Message *msg = bucket.msgs[i].get();
+            if (msg->functionalWrite(pkt)) {
+                num_functional_writes++;
+            }
         }
     }
 
@@ -370,7 +526,7 @@ MessageBuffer::functionalWrite(Packet *pkt)
          map_iter != m_stall_msg_map.end();
          ++map_iter) {
 
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
+        for (StallList::iterator it = (map_iter->second).begin();
             it != (map_iter->second).end(); ++it) {
 
             Message *msg = (*it).get();
@@ -380,9 +536,67 @@ MessageBuffer::functionalWrite(Packet *pkt)
         }
     }
 
+    // Check the messages still on their way from another event queue.
+    // This is only done outside parallel simulation, but the senders
+    // may have been running until just now.
+    std::lock_guard<std::mutex> lock(m_in_flight_mutex);
+    for (auto &msg : m_in_flight) {
+        if (msg->functionalWrite(pkt)) {
+            num_functional_writes++;
+        }
+    }
+
     return num_functional_writes;
 }
 
+bool
+MessageBuffer::functionalRead(Packet *pkt)
+{
+    for (auto &bucket : m_ready) {
+        for (unsigned int i = bucket.head; i < bucket.msgs.size(); ++i) {
+            if (bucket.msgs[i]->functionalRead(pkt))
+                return true;
+        }
+    }
+
+    for (auto &stalled : m_stall_msg_map) {
+        for (auto &msg : stalled.second) {
+            if (msg->functionalRead(pkt))
+                return true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_in_flight_mutex);
+    for (auto &msg : m_in_flight) {
+        if (msg->functionalRead(pkt))
+            return true;
+    }
+
+    return false;
+}
+
+void
+MessageBuffer::regStats()
+{
+    m_stall_count
+        .name(name() + ".stalled_msgs")
+        .desc("Number of messages stalled on an address")
+        .flags(Stats::nozero)
+        ;
+
+    m_reanalyze_count
+        .name(name() + ".reanalyzed_msgs")
+        .desc("Number of stalled messages woken up")
+        .flags(Stats::nozero)
+        ;
+
+    m_stall_queue_depth
+        .name(name() + ".avg_stall_queue_depth")
+        .desc("Average number of stalled messages")
+        .flags(Stats::nozero)
+        ;
+}
+
 MessageBuffer *
 MessageBufferParams::create()
 {
@@ -34,13 +34,17 @@
 #ifndef __MEM_RUBY_BUFFERS_MESSAGEBUFFER_HH__
 #define __MEM_RUBY_BUFFERS_MESSAGEBUFFER_HH__
 
-#include <algorithm>
 #include <cassert>
-#include <functional>
+#include <deque>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/statistics.hh"
+
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
@@ -65,10 +69,8 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = peekMsgPtr();
+        popReady();
         enqueue(m, current_time, delta);
     }
 
@@ -94,16 +96,31 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &
+    peekMsgPtr() const
+    {
+        const ReadyBucket &bucket = m_ready.front();
+        return bucket.msgs[bucket.head];
+    }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
+    /**
+     * Allow messages to be enqueued from an event queue other than the
+     * one of the consumer. This is only safe when the enqueue delay is
+     * at least the lookahead declared between the two event queues,
+     * i.e., for buffers at the end of a network link. Messages then
+     * travel to the consumer's event queue as asynchronous events and
+     * are only inserted in the buffer when they arrive.
+     */
+    void allowCrossQueue();
+
     //! Updates the delay cycles of the message at the head of the queue,
     //! removes it from the queue and returns its total delay.
     Tick dequeue(Tick current_time);
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return m_ready_size == 0; }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -122,20 +139,88 @@ class MessageBuffer : public SimObject
     // This required for debugging the code.
     uint32_t functionalWrite(Packet *pkt);
 
+    // Function for reading the data of any of the messages in the
+    // buffer, including those on their way from another event queue.
+    bool functionalRead(Packet *pkt);
+
+    void regStats();
+
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    typedef std::list<MsgPtr> InFlightList;
+
+    /** Event delivering a message enqueued from another event queue. */
+    class DeliveryEvent : public Event
+    {
+      private:
+        MessageBuffer &buffer;
+        MsgPtr message;
+
+        // Message counter given by the sender
+        const uint64_t counter;
+
+        // Entry of the message in the buffer's in-flight list
+        const InFlightList::iterator inFlight;
+
+      public:
+        // Deliver before the consumer wakes up in the arrival tick
+        DeliveryEvent(MessageBuffer &_buffer, const MsgPtr &_message,
+                      uint64_t _counter, InFlightList::iterator _in_flight)
+            : Event(Default_Pri - 1, AutoDelete), buffer(_buffer),
+              message(_message), counter(_counter), inFlight(_in_flight)
+        { }
+
+        void
+        process()
+        {
+            buffer.deliverMessage(message, counter, inFlight);
+        }
+
+        const char *description() const { return "message delivery"; }
+    };
+
+    /**
+     * Messages with the same arrival tick, in message counter order.
+     * Messages before head have been dequeued already.
+     */
+    struct ReadyBucket
+    {
+        Tick time;
+        unsigned int head;
+        std::vector<MsgPtr> msgs;
+    };
+
+    typedef std::vector<MsgPtr> StallList;
+
+    void insertMessage(const MsgPtr &message);
+    void deliverMessage(const MsgPtr &message, uint64_t counter,
+                        InFlightList::iterator in_flight);
+    void insertReady(const MsgPtr &message);
+    void popReady();
+    void reanalyzeList(StallList &, Tick);
+    void updateStallDepth();
 
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    // Messages bucketed by arrival tick, ordered by (tick, message
+    // counter) like the priority heap this replaces. A buffer only has
+    // a few distinct arrival ticks in flight, so the bucket of a new
+    // message is found by a short walk from the back and taking the
+    // head is constant time. The message vectors of drained buckets
+    // are kept for reuse to avoid allocations.
+    std::deque<ReadyBucket> m_ready;
+    std::vector<std::vector<MsgPtr> > m_spare_buckets;
+    unsigned int m_ready_size;
+
+    // Stalled messages by address. The map is unordered for constant
+    // time stalls and wakeups; reanalyzeAllMessages sorts the
+    // addresses to keep a well-defined, address-ordered wakeup.
+    typedef std::unordered_map<Addr, StallList> StallMsgMapType;
 
     StallMsgMapType m_stall_msg_map;
+    unsigned int m_stall_size;
 
     const unsigned int m_max_size;
     Tick m_time_last_time_size_checked;
@@ -159,6 +244,26 @@ class MessageBuffer : public SimObject
 
     int m_input_link_id;
     int m_vnet_id;
+
+    //! May messages be enqueued from another event queue
+    bool m_cross_queue;
+
+    // State of the sender when enqueueing from another event queue,
+    // only ever touched by the sender's thread. The single sender
+    // stamps the messages with its own counter, which orders the
+    // messages arriving at the same time regardless of the order in
+    // which they are delivered.
+    uint64_t m_send_counter;
+    Tick m_send_last_arrival_time;
+
+    // Messages enqueued from another event queue that have not been
+    // delivered yet, for functional accesses.
+    std::mutex m_in_flight_mutex;
+    InFlightList m_in_flight;
+
+    Stats::Scalar m_stall_count;
+    Stats::Scalar m_reanalyze_count;
+    Stats::Average m_stall_queue_depth;
 };
 
 Tick random_time();
@@ -55,6 +55,15 @@ Topology::Topology(uint32_t num_routers,
     // Total nodes/controllers in network
     assert(m_nodes > 1);
 
+    // NetDest has room for NUMBER_BITS_PER_SET machines of each type
+    for (MachineType m = MachineType_FIRST; m < MachineType_NUM; ++m) {
+        fatal_if(MachineType_base_count(m) > NUMBER_BITS_PER_SET,
+                 "Number of bits(%d) < number of %s controllers(%d). "
+                 "Increase NUMBER_BITS_PER_SET and recompile.\n",
+                 NUMBER_BITS_PER_SET, MachineType_to_string(m),
+                 MachineType_base_count(m));
+    }
+
     // analyze both the internal and external links, create data structures
     // Note that the python created links are bi-directional, but that the
     // topology and networks utilize uni-directional links.  Thus each 
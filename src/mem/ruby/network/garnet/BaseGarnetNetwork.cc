@@ -50,6 +50,16 @@ BaseGarnetNetwork::BaseGarnetNetwork(const Params *p)
         if (ext_link->params()->bandwidth_factor != m_ni_flit_size) {
             fatal("Garnet only supports uniform bw across all links and NIs\n");
         }
+        // The routers, links and network interfaces all wake each other
+        // up directly, so Garnet cannot be split across event queues
+        fatal_if(ext_link->params()->ext_node->eventQueue() != eventQueue(),
+                 "%s must be on the event queue of %s\n",
+                 ext_link->params()->ext_node->name(), name());
+    }
+    for (auto router : p->routers) {
+        fatal_if(router->eventQueue() != eventQueue(),
+                 "%s must be on the event queue of %s\n", router->name(),
+                 name());
     }
     for (std::vector<BasicIntLink*>::const_iterator i =  p->int_links.begin();
          i != p->int_links.end(); ++i) {
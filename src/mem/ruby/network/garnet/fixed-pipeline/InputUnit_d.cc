@@ -55,6 +55,8 @@ InputUnit_d::InputUnit_d(int id, Router_d *router) : Consumer(router)
     for (int i=0; i < m_num_vcs; i++) {
         m_vcs[i] = new VirtualChannel_d(i);
     }
+    m_vc_ab_mask.resize(m_num_vcs);
+    m_active_mask.resize(m_num_vcs);
 }
 
 InputUnit_d::~InputUnit_d()
@@ -38,6 +38,7 @@
 #include "mem/ruby/network/garnet/fixed-pipeline/CreditLink_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/NetworkLink_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/Router_d.hh"
+#include "mem/ruby/network/garnet/fixed-pipeline/VcMask_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/VirtualChannel_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/flitBuffer_d.hh"
 #include "mem/ruby/network/garnet/NetworkHeader.hh"
@@ -58,6 +59,7 @@ class InputUnit_d : public Consumer
     set_vc_state(VC_state_type state, int vc, Cycles curTime)
     {
         m_vcs[vc]->set_state(state, curTime);
+        update_vc_masks(vc, state);
     }
 
     inline void
@@ -103,14 +105,22 @@ class InputUnit_d : public Consumer
     {
         m_vcs[vc]->set_outport(outport);
         m_vcs[vc]->set_state(VC_AB_, curTime);
+        update_vc_masks(vc, VC_AB_);
     }
 
     inline void
     grant_vc(int in_vc, int out_vc, Cycles curTime)
     {
         m_vcs[in_vc]->grant_vc(out_vc, curTime);
+        update_vc_masks(in_vc, ACTIVE_);
     }
 
+    /** VCs waiting for VC allocation (in the VC_AB_ state). */
+    const VcMask_d& get_vc_ab_mask() const { return m_vc_ab_mask; }
+
+    /** VCs holding an output VC (in the ACTIVE_ state). */
+    const VcMask_d& get_active_mask() const { return m_active_mask; }
+
     inline flit_d*
     peekTopFlit(int vc)
     {
@@ -162,6 +172,20 @@ class InputUnit_d : public Consumer
     void resetStats();
 
   private:
+    inline void
+    update_vc_masks(int vc, VC_state_type state)
+    {
+        if (state == VC_AB_)
+            m_vc_ab_mask.set(vc);
+        else
+            m_vc_ab_mask.clear(vc);
+
+        if (state == ACTIVE_)
+            m_active_mask.set(vc);
+        else
+            m_active_mask.clear(vc);
+    }
+
     int m_id;
     int m_num_vcs;
     int m_vc_per_vnet;
@@ -174,6 +198,11 @@ class InputUnit_d : public Consumer
     // Virtual channels
     std::vector<VirtualChannel_d *> m_vcs;
 
+    // Only VCs in these two sets can need the VA or SA stages, every
+    // other VC is idle
+    VcMask_d m_vc_ab_mask;
+    VcMask_d m_active_mask;
+
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
     std::vector<double> m_num_buffer_reads;
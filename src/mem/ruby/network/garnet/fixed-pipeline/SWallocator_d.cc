@@ -100,11 +100,15 @@ SWallocator_d::arbitrate_inports()
             next_round_robin_invc = 0;
         m_round_robin_inport[inport] = next_round_robin_invc;
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
-
+        // Only VCs holding an output VC can need switch allocation;
+        // visit them in the same round-robin order as the arbiter
+        const VcMask_d &active = m_input_unit[inport]->get_active_mask();
+        if (active.empty())
+            continue;
+
+        int first = active.findNextWrap(next_round_robin_invc);
+        invc = first;
+        do {
             if (m_input_unit[inport]->need_stage(invc, ACTIVE_, SA_,
                                                  m_router->curCycle()) &&
                 m_input_unit[inport]->has_credits(invc)) {
@@ -117,7 +121,8 @@ SWallocator_d::arbitrate_inports()
                     break; // got one vc winner for this port
                 }
             }
-        }
+            invc = active.findNextWrap(invc + 1);
+        } while (invc != first);
     }
 }
 
@@ -213,7 +218,8 @@ SWallocator_d::check_for_wakeup()
     Cycles nextCycle = m_router->curCycle() + Cycles(1);
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
+        const VcMask_d &active = m_input_unit[i]->get_active_mask();
+        for (int j = active.findNext(0); j >= 0; j = active.findNext(j + 1)) {
             if (m_input_unit[i]->need_stage(j, ACTIVE_, SA_, nextCycle)) {
                 m_router->vcarb_req();
                 return;
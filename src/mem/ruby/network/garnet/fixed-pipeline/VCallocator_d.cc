@@ -28,6 +28,8 @@
  * Authors: Niket Agarwal
  */
 
+#include <algorithm>
+
 #include "mem/ruby/network/garnet/fixed-pipeline/GarnetNetwork_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/InputUnit_d.hh"
 #include "mem/ruby/network/garnet/fixed-pipeline/OutputUnit_d.hh"
@@ -95,18 +97,17 @@ VCallocator_d::init()
 void
 VCallocator_d::clear_request_vector()
 {
-    for (int i = 0; i < m_num_outports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (!m_outvc_is_req[i][j])
-                continue;
-            m_outvc_is_req[i][j] = false;
-            for (int k = 0; k < m_num_inports; k++) {
-                for (int l = 0; l < m_num_vcs; l++) {
-                    m_outvc_req[i][j][k][l] = false;
-                }
+    for (auto &req : m_outvc_req_list) {
+        int i = req.first;
+        int j = req.second;
+        m_outvc_is_req[i][j] = false;
+        for (int k = 0; k < m_num_inports; k++) {
+            for (int l = 0; l < m_num_vcs; l++) {
+                m_outvc_req[i][j][k][l] = false;
             }
         }
     }
+    m_outvc_req_list.clear();
 }
 
 void
@@ -168,8 +169,10 @@ VCallocator_d::select_outvc(int inport_iter, int invc_iter)
         if (m_output_unit[outport]->is_vc_idle(outvc, m_router->curCycle())) {
             m_local_arbiter_activity[vnet]++;
             m_outvc_req[outport][outvc][inport_iter][invc_iter] = true;
-            if (!m_outvc_is_req[outport][outvc])
+            if (!m_outvc_is_req[outport][outvc]) {
                 m_outvc_is_req[outport][outvc] = true;
+                m_outvc_req_list.push_back(std::make_pair(outport, outvc));
+            }
             return; // out vc acquired
         }
     }
@@ -179,7 +182,11 @@ void
 VCallocator_d::arbitrate_invcs()
 {
     for (int inport_iter = 0; inport_iter < m_num_inports; inport_iter++) {
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
+        // Only VCs in the VC_AB_ state can need VC allocation
+        const VcMask_d &waiting =
+            m_input_unit[inport_iter]->get_vc_ab_mask();
+        for (int invc_iter = waiting.findNext(0); invc_iter >= 0;
+             invc_iter = waiting.findNext(invc_iter + 1)) {
             if (m_input_unit[inport_iter]->need_stage(invc_iter, VC_AB_,
                     VA_, m_router->curCycle())) {
                 if (!is_invc_candidate(inport_iter, invc_iter))
@@ -194,47 +201,46 @@ VCallocator_d::arbitrate_invcs()
 void
 VCallocator_d::arbitrate_outvcs()
 {
-    for (int outport_iter = 0; outport_iter < m_num_outports; outport_iter++) {
-        for (int outvc_iter = 0; outvc_iter < m_num_vcs; outvc_iter++) {
-            if (!m_outvc_is_req[outport_iter][outvc_iter]) {
-                // No requests for this outvc in this cycle
-                continue;
-            }
+    // Only visit the output VCs that were requested this cycle, in the
+    // same (outport, outvc) order as a full scan would
+    std::sort(m_outvc_req_list.begin(), m_outvc_req_list.end());
 
-            int inport = m_round_robin_outvc[outport_iter][outvc_iter].first;
-            int invc_offset =
-                m_round_robin_outvc[outport_iter][outvc_iter].second;
-            int vnet = get_vnet(outvc_iter);
-            int invc_base = vnet*m_vc_per_vnet;
-            int num_vcs_per_vnet = m_vc_per_vnet;
+    for (auto &req : m_outvc_req_list) {
+        int outport_iter = req.first;
+        int outvc_iter = req.second;
+        int inport = m_round_robin_outvc[outport_iter][outvc_iter].first;
+        int invc_offset =
+            m_round_robin_outvc[outport_iter][outvc_iter].second;
+        int vnet = get_vnet(outvc_iter);
+        int invc_base = vnet*m_vc_per_vnet;
+        int num_vcs_per_vnet = m_vc_per_vnet;
 
-            m_round_robin_outvc[outport_iter][outvc_iter].second++;
-            if (m_round_robin_outvc[outport_iter][outvc_iter].second >=
-               num_vcs_per_vnet) {
-                m_round_robin_outvc[outport_iter][outvc_iter].second = 0;
-                m_round_robin_outvc[outport_iter][outvc_iter].first++;
-                if (m_round_robin_outvc[outport_iter][outvc_iter].first >=
-                   m_num_inports)
-                    m_round_robin_outvc[outport_iter][outvc_iter].first = 0;
+        m_round_robin_outvc[outport_iter][outvc_iter].second++;
+        if (m_round_robin_outvc[outport_iter][outvc_iter].second >=
+           num_vcs_per_vnet) {
+            m_round_robin_outvc[outport_iter][outvc_iter].second = 0;
+            m_round_robin_outvc[outport_iter][outvc_iter].first++;
+            if (m_round_robin_outvc[outport_iter][outvc_iter].first >=
+               m_num_inports)
+                m_round_robin_outvc[outport_iter][outvc_iter].first = 0;
+        }
+        for (int in_iter = 0; in_iter < m_num_inports*num_vcs_per_vnet;
+                in_iter++) {
+            invc_offset++;
+            if (invc_offset >= num_vcs_per_vnet) {
+                invc_offset = 0;
+                inport++;
+                if (inport >= m_num_inports)
+                    inport = 0;
             }
-            for (int in_iter = 0; in_iter < m_num_inports*num_vcs_per_vnet;
-                    in_iter++) {
-                invc_offset++;
-                if (invc_offset >= num_vcs_per_vnet) {
-                    invc_offset = 0;
-                    inport++;
-                    if (inport >= m_num_inports)
-                        inport = 0;
-                }
-                int invc = invc_base + invc_offset;
-                if (m_outvc_req[outport_iter][outvc_iter][inport][invc]) {
-                    m_global_arbiter_activity[vnet]++;
-                    m_input_unit[inport]->grant_vc(invc, outvc_iter,
-                        m_router->curCycle());
-                    m_output_unit[outport_iter]->update_vc(
-                        outvc_iter, inport, invc);
-                    break;
-                }
+            int invc = invc_base + invc_offset;
+            if (m_outvc_req[outport_iter][outvc_iter][inport][invc]) {
+                m_global_arbiter_activity[vnet]++;
+                m_input_unit[inport]->grant_vc(invc, outvc_iter,
+                    m_router->curCycle());
+                m_output_unit[outport_iter]->update_vc(
+                    outvc_iter, inport, invc);
+                break;
             }
         }
     }
@@ -255,7 +261,9 @@ VCallocator_d::check_for_wakeup()
     Cycles nextCycle = m_router->curCycle() + Cycles(1);
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
+        const VcMask_d &waiting = m_input_unit[i]->get_vc_ab_mask();
+        for (int j = waiting.findNext(0); j >= 0;
+             j = waiting.findNext(j + 1)) {
             if (m_input_unit[i]->need_stage(j, VC_AB_, VA_, nextCycle)) {
                 m_router->vcarb_req();
                 return;
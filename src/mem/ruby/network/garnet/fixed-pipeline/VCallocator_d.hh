@@ -83,6 +83,9 @@ class VCallocator_d : public Consumer
 
     std::vector<std::vector<bool> > m_outvc_is_req;
 
+    // (outport, outvc) pairs with m_outvc_is_req set
+    std::vector<std::pair<int, int> > m_outvc_req_list;
+
     std::vector<InputUnit_d *> m_input_unit;
     std::vector<OutputUnit_d *> m_output_unit;
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_FIXED_PIPELINE_VC_MASK_D_HH__
+#define __MEM_RUBY_NETWORK_GARNET_FIXED_PIPELINE_VC_MASK_D_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+/**
+ * Set of virtual channels of an input unit, kept as a bitmask so that
+ * the allocators only visit the VCs that can possibly need them
+ * instead of scanning every VC of every port each cycle.
+ */
+class VcMask_d
+{
+  public:
+    VcMask_d() : m_num_vcs(0), m_count(0) {}
+
+    void
+    resize(int num_vcs)
+    {
+        m_num_vcs = num_vcs;
+        m_words.assign((num_vcs + 63) / 64, 0);
+        m_count = 0;
+    }
+
+    bool
+    test(int vc) const
+    {
+        return (m_words[vc / 64] >> (vc % 64)) & 1;
+    }
+
+    void
+    set(int vc)
+    {
+        if (!test(vc)) {
+            m_words[vc / 64] |= (uint64_t)1 << (vc % 64);
+            m_count++;
+        }
+    }
+
+    void
+    clear(int vc)
+    {
+        if (test(vc)) {
+            m_words[vc / 64] &= ~((uint64_t)1 << (vc % 64));
+            m_count--;
+        }
+    }
+
+    bool empty() const { return m_count == 0; }
+    int count() const { return m_count; }
+
+    /** First VC in the set at or after vc, -1 if there is none. */
+    int
+    findNext(int vc) const
+    {
+        if (vc >= m_num_vcs)
+            return -1;
+        int word = vc / 64;
+        uint64_t bits = m_words[word] & (~(uint64_t)0 << (vc % 64));
+        while (!bits) {
+            if (++word == (int)m_words.size())
+                return -1;
+            bits = m_words[word];
+        }
+        return word * 64 + findLsbSet(bits);
+    }
+
+    /**
+     * First VC in the set at or after vc, wrapping around to the
+     * lowest VC, -1 if the set is empty. This is the order in which
+     * a round-robin arbiter starting at vc visits the VCs.
+     */
+    int
+    findNextWrap(int vc) const
+    {
+        int next = findNext(vc);
+        return next >= 0 ? next : findNext(0);
+    }
+
+  private:
+    int m_num_vcs;
+    int m_count;
+    std::vector<uint64_t> m_words;
+};
+
+#endif // __MEM_RUBY_NETWORK_GARNET_FIXED_PIPELINE_VC_MASK_D_HH__
@@ -94,6 +94,7 @@ PerfectSwitch::addOutPort(const vector<MessageBuffer*>& out,
     // Add to routing table
     m_out.push_back(out);
     m_routing_table.push_back(routing_table_entry);
+    m_route_cache.clear();
 }
 
 PerfectSwitch::~PerfectSwitch()
@@ -134,6 +135,53 @@ PerfectSwitch::operateVnet(int vnet)
     }
 }
 
+void
+PerfectSwitch::computeRoute(NetDest msg_dsts, Route &route)
+{
+    route.links.clear();
+    route.dests.clear();
+
+    for (int i = 0; i < m_routing_table.size(); i++) {
+        // pick the next link to look at
+        int link = m_link_order[i].m_link;
+        const NetDest &dst = m_routing_table[link];
+        DPRINTF(RubyNetwork, "dst: %s\n", dst);
+
+        if (!msg_dsts.intersectionIsNotEmpty(dst))
+            continue;
+
+        // Remember what link we're using
+        route.links.push_back(link);
+
+        // Need to remember which destinations need this message in
+        // another vector.  This Set is the intersection of the
+        // routing_table entry and the current destination set.  The
+        // intersection must not be empty, since we are inside "if"
+        route.dests.push_back(msg_dsts.AND(dst));
+
+        // Next, we update the msg_destination not to include
+        // those nodes that were already handled by this link
+        msg_dsts.removeNetDest(dst);
+    }
+
+    assert(msg_dsts.count() == 0);
+}
+
+const PerfectSwitch::Route &
+PerfectSwitch::lookupRoute(const NetDest &dests)
+{
+    auto it = m_route_cache.find(dests);
+    if (it != m_route_cache.end())
+        return it->second;
+
+    if (m_route_cache.size() >= maxCachedRoutes)
+        m_route_cache.clear();
+
+    Route &route = m_route_cache[dests];
+    computeRoute(dests, route);
+    return route;
+}
+
 void
 PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
                                     int vnet)
@@ -141,9 +189,8 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
     MsgPtr msg_ptr;
     Message *net_msg_ptr = NULL;
 
-    // temporary vectors to store the routing results
-    vector<LinkID> output_links;
-    vector<NetDest> output_link_destinations;
+    // temporary storage for adaptively routed messages
+    Route adaptive_route;
     Tick current_time = m_switch->clockEdge();
 
     while (buffer->isReady(current_time)) {
@@ -154,9 +201,7 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
         net_msg_ptr = msg_ptr.get();
         DPRINTF(RubyNetwork, "Message: %s\n", (*net_msg_ptr));
 
-        output_links.clear();
-        output_link_destinations.clear();
-        NetDest msg_dsts = net_msg_ptr->getDestination();
+        const NetDest &msg_dsts = net_msg_ptr->getDestination();
 
         // Unfortunately, the token-protocol sends some
         // zero-destination messages, so this assert isn't valid
@@ -165,56 +210,41 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
         assert(m_link_order.size() == m_routing_table.size());
         assert(m_link_order.size() == m_out.size());
 
-        if (m_network_ptr->getAdaptiveRouting()) {
-            if (m_network_ptr->isVNetOrdered(vnet)) {
-                // Don't adaptively route
-                for (int out = 0; out < m_out.size(); out++) {
-                    m_link_order[out].m_link = out;
-                    m_link_order[out].m_value = 0;
-                }
-            } else {
-                // Find how clogged each link is
-                for (int out = 0; out < m_out.size(); out++) {
-                    int out_queue_length = 0;
-                    for (int v = 0; v < m_virtual_networks; v++) {
-                        out_queue_length += m_out[out][v]->getSize(current_time);
-                    }
-                    int value =
-                        (out_queue_length << 8) |
-                        random_mt.random(0, 0xff);
-                    m_link_order[out].m_link = out;
-                    m_link_order[out].m_value = value;
+        const Route *route;
+        if (m_network_ptr->getAdaptiveRouting() &&
+            m_network_ptr->isVNetOrdered(vnet)) {
+            // Don't adaptively route
+            for (int out = 0; out < m_out.size(); out++) {
+                m_link_order[out].m_link = out;
+                m_link_order[out].m_value = 0;
+            }
+            route = &lookupRoute(msg_dsts);
+        } else if (m_network_ptr->getAdaptiveRouting()) {
+            // Find how clogged each link is
+            for (int out = 0; out < m_out.size(); out++) {
+                int out_queue_length = 0;
+                for (int v = 0; v < m_virtual_networks; v++) {
+                    out_queue_length += m_out[out][v]->getSize(current_time);
                 }
-
-                // Look at the most empty link first
-                sort(m_link_order.begin(), m_link_order.end());
+                int value =
+                    (out_queue_length << 8) |
+                    random_mt.random(0, 0xff);
+                m_link_order[out].m_link = out;
+                m_link_order[out].m_value = value;
             }
-        }
-
-        for (int i = 0; i < m_routing_table.size(); i++) {
-            // pick the next link to look at
-            int link = m_link_order[i].m_link;
-            NetDest dst = m_routing_table[link];
-            DPRINTF(RubyNetwork, "dst: %s\n", dst);
-
-            if (!msg_dsts.intersectionIsNotEmpty(dst))
-                continue;
-
-            // Remember what link we're using
-            output_links.push_back(link);
 
-            // Need to remember which destinations need this message in
-            // another vector.  This Set is the intersection of the
-            // routing_table entry and the current destination set.  The
-            // intersection must not be empty, since we are inside "if"
-            output_link_destinations.push_back(msg_dsts.AND(dst));
+            // Look at the most empty link first
+            sort(m_link_order.begin(), m_link_order.end());
 
-            // Next, we update the msg_destination not to include
-            // those nodes that were already handled by this link
-            msg_dsts.removeNetDest(dst);
+            computeRoute(msg_dsts, adaptive_route);
+            route = &adaptive_route;
+        } else {
+            // The link order never changes without adaptive routing
+            route = &lookupRoute(msg_dsts);
         }
 
-        assert(msg_dsts.count() == 0);
+        const vector<LinkID> &output_links = route->links;
+        const vector<NetDest> &output_link_destinations = route->dests;
 
         // Check for resources - for all outgoing queues
         bool enough = true;
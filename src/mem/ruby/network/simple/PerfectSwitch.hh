@@ -38,12 +38,13 @@
 
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
 
 class MessageBuffer;
-class NetDest;
 class SimpleNetwork;
 class Switch;
 
@@ -84,9 +85,23 @@ class PerfectSwitch : public Consumer
     PerfectSwitch(const PerfectSwitch& obj);
     PerfectSwitch& operator=(const PerfectSwitch& obj);
 
+    // The output links a message goes out on, and the destinations
+    // each of them is responsible for.
+    struct Route
+    {
+        std::vector<LinkID> links;
+        std::vector<NetDest> dests;
+    };
+
     void operateVnet(int vnet);
     void operateMessageBuffer(MessageBuffer *b, int incoming, int vnet);
 
+    // Split dests over the output links, in the order of m_link_order
+    void computeRoute(NetDest dests, Route &route);
+
+    // Route of dests for the static link order, from m_route_cache
+    const Route &lookupRoute(const NetDest &dests);
+
     const SwitchID m_switch_id;
     Switch * const m_switch;
 
@@ -97,6 +112,13 @@ class PerfectSwitch : public Consumer
     std::vector<NetDest> m_routing_table;
     std::vector<LinkOrder> m_link_order;
 
+    // Routes computed so far for the static link order, by destination.
+    // Protocols only use a handful of destination sets per switch, the
+    // broadcasts foremost, so this saves splitting them over the links
+    // for every message. It is flushed when it grows too large.
+    std::unordered_map<NetDest, Route> m_route_cache;
+    static const size_t maxCachedRoutes = 1024;
+
     uint32_t m_virtual_networks;
     int m_round_robin_start;
     int m_wakeups_wo_switch;
@@ -88,6 +88,9 @@ SimpleNetwork::makeOutLink(SwitchID src, NodeID dest, BasicLink* link,
 
     SimpleExtLink *simple_link = safe_cast<SimpleExtLink*>(link);
 
+    connectQueues(src, simple_link->params()->ext_node->eventQueue(),
+                  m_fromNetQueues[dest], simple_link->m_latency);
+
     m_switches[src]->addOutPort(m_fromNetQueues[dest], routing_table_entry,
                                 simple_link->m_latency,
                                 simple_link->m_bw_multiplier);
@@ -100,6 +103,15 @@ SimpleNetwork::makeInLink(NodeID src, SwitchID dest, BasicLink* link,
                           const NetDest& routing_table_entry)
 {
     assert(src < m_nodes);
+
+    // Controllers enqueue straight into the switch, without the link
+    // latency that would let the two run on different event queues
+    AbstractController *cntrl =
+        safe_cast<BasicExtLink*>(link)->params()->ext_node;
+    fatal_if(cntrl->eventQueue() != m_switches[dest]->eventQueue(),
+             "%s must be on the event queue of %s, the switch it sends "
+             "to\n", cntrl->name(), m_switches[dest]->name());
+
     m_switches[dest]->addInPort(m_toNetQueues[src]);
 }
 
@@ -123,12 +135,38 @@ SimpleNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
     // Connect it to the two switches
     SimpleIntLink *simple_link = safe_cast<SimpleIntLink*>(link);
 
+    connectQueues(src, m_switches[dest]->eventQueue(), queues,
+                  simple_link->m_latency);
+
     m_switches[dest]->addInPort(queues);
     m_switches[src]->addOutPort(queues, routing_table_entry,
                                 simple_link->m_latency,
                                 simple_link->m_bw_multiplier);
 }
 
+void
+SimpleNetwork::connectQueues(SwitchID src, EventQueue *dest_queue,
+                             const vector<MessageBuffer*>& buffers,
+                             Cycles link_latency)
+{
+    Switch *sw = m_switches[src];
+    if (sw->eventQueue() == dest_queue)
+        return;
+
+    // Adaptive routing breaks ties with the shared random number
+    // generator, which the switches cannot use from several threads
+    fatal_if(m_adaptive_routing, "%s: adaptive routing cannot be used "
+             "with a network that spans several event queues\n", name());
+
+    // The throttle of the switch delays every message by the link
+    // latency, so the other side can run up to that far ahead
+    for (auto buffer : buffers)
+        buffer->allowCrossQueue();
+
+    declareLookahead(sw->eventQueue()->index(), dest_queue->index(),
+                     sw->cyclesToTicks(link_latency));
+}
+
 void
 SimpleNetwork::regStats()
 {
@@ -75,6 +75,14 @@ class SimpleNetwork : public Network
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    /**
+     * Let a switch on one event queue send over a link to a consumer
+     * on another one, declaring the link latency as the lookahead.
+     */
+    void connectQueues(SwitchID src, EventQueue *dest_queue,
+                       const std::vector<MessageBuffer*>& buffers,
+                       Cycles link_latency);
+
     void addLink(SwitchID src, SwitchID dest, int link_latency);
     void makeLink(SwitchID src, SwitchID dest,
         const NetDest& routing_table_entry, int link_latency);
@@ -31,7 +31,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -158,6 +157,19 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // The entry held by a way, NULL if the way is empty.
+    AbstractCacheEntry *&
+    entryAt(int64_t cacheSet, int way)
+    {
+        return m_cache[cacheSet * m_cache_assoc + way];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t cacheSet, int way) const
+    {
+        return m_cache[cacheSet * m_cache_assoc + way];
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -166,10 +178,12 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // The entries and their tags, stored set after set with the ways
+    // of a set next to each other, so that a lookup only scans the
+    // assoc consecutive tags of its set. The tag of an empty way is
+    // MaxAddr, which no line address can match.
+    std::vector<AbstractCacheEntry*> m_cache;
+    std::vector<Addr> m_tags;
 
     AbstractReplacementPolicy *m_replacementPolicy_ptr;
 
@@ -27,6 +27,10 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
 #include "debug/RubyCacheTrace.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "mem/ruby/system/RubySystem.hh"
@@ -45,18 +49,21 @@ TraceRecord::print(ostream& out) const
 CacheRecorder::CacheRecorder()
     : m_uncompressed_trace(NULL),
       m_uncompressed_trace_size(0),
-      m_block_size_bytes(RubySystem::getBlockSizeBytes())
+      m_block_size_bytes(RubySystem::getBlockSizeBytes()),
+      m_parallel_fetch(false)
 {
 }
 
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<Sequencer*>& seq_map,
-                             uint64_t block_size_bytes)
+                             uint64_t block_size_bytes,
+                             bool parallel_fetch)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
       m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
-      m_records_flushed(0), m_block_size_bytes(block_size_bytes)
+      m_records_flushed(0), m_block_size_bytes(block_size_bytes),
+      m_parallel_fetch(parallel_fetch)
 {
     if (m_uncompressed_trace != NULL) {
         if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
@@ -67,6 +74,40 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
     }
+
+    if (m_parallel_fetch) {
+        // Split the trace by sequencer, keeping the recorded order
+        // within each share. Controllers without a sequencer share the
+        // sequencer they were mapped to. Every record also remembers
+        // the record before it in the trace that goes to the same
+        // line, which has to complete before it is issued.
+        std::unordered_map<Addr, uint64_t> last_of_line;
+        uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+        for (uint64_t offset = 0; offset < m_uncompressed_trace_size;
+             offset += record_size) {
+            TraceRecord *rec =
+                (TraceRecord *)(m_uncompressed_trace + offset);
+            Sequencer *seq = m_seq_map[rec->m_cntrl_id];
+            assert(seq != NULL);
+
+            uint64_t idx = m_fetch_records.size();
+            auto last = last_of_line.find(rec->m_data_address);
+            m_fetch_records.push_back(FetchRecord{
+                    rec, last == last_of_line.end() ? 0 : last->second + 1,
+                    -1, false});
+            last_of_line[rec->m_data_address] = idx;
+
+            auto share = std::find_if(m_fetch_shares.begin(),
+                                      m_fetch_shares.end(),
+                                      [seq](const FetchShare &s)
+                                      { return s.seq == seq; });
+            if (share == m_fetch_shares.end()) {
+                m_fetch_shares.push_back(FetchShare{seq, {}, 0, 0, 0});
+                share = m_fetch_shares.end() - 1;
+            }
+            share->records.push_back(idx);
+        }
+    }
 }
 
 CacheRecorder::~CacheRecorder()
@@ -100,6 +141,42 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+int
+CacheRecorder::issueFetchRequests(TraceRecord *traceRecord, Sequencer *seq)
+{
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+
+    int issued = 0;
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        Request* req = nullptr;
+        MemCmd::Command requestType;
+
+        if (traceRecord->m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = new Request(traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
+        }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = new Request(traceRecord->m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcMasterId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = new Request(traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
+        }
+
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+
+        assert(seq != NULL);
+        seq->makeRequest(pkt);
+        issued++;
+    }
+    return issued;
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
@@ -107,41 +184,124 @@ CacheRecorder::enqueueNextFetchRequest()
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
                                                                 m_bytes_read);
 
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
-
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            Request* req = nullptr;
-            MemCmd::Command requestType;
-
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcMasterId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = new Request(traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0, Request::funcMasterId);
-            }
+        issueFetchRequests(traceRecord, m_seq_map[traceRecord->m_cntrl_id]);
 
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        m_records_read++;
+    } else {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+    }
+}
+
+void
+CacheRecorder::enqueueNextShareRequest(int share)
+{
+    FetchShare &fs = m_fetch_shares[share];
+    assert(fs.outstanding == 0);
+    if (fs.next < fs.records.size()) {
+        uint64_t idx = fs.records[fs.next];
+        FetchRecord &fr = m_fetch_records[idx];
 
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
+        // The accesses to a line are replayed in the recorded order
+        // across all shares, so that every line ends up in the same
+        // coherence state as after a serial replay. If an earlier
+        // access to the line is still pending, wait for it.
+        if (fr.prev && !m_fetch_records[fr.prev - 1].done) {
+            DPRINTF(RubyCacheTrace, "Share %d waits for %s\n", share,
+                    *m_fetch_records[fr.prev - 1].rec);
+            assert(m_fetch_records[fr.prev - 1].waiter == -1);
+            m_fetch_records[fr.prev - 1].waiter = share;
+            return;
         }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        fs.outstanding = issueFetchRequests(fr.rec, fs.seq);
+        fs.current = idx;
+        fs.next++;
         m_records_read++;
     } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        DPRINTF(RubyCacheTrace, "Fetched all %d records of share %d\n",
+                fs.records.size(), share);
+    }
+}
+
+void
+CacheRecorder::startFetchRequests()
+{
+    if (!m_parallel_fetch) {
+        enqueueNextFetchRequest();
+        return;
+    }
+
+    DPRINTF(RubyCacheTrace, "Fetching records through %d sequencers\n",
+            m_fetch_shares.size());
+    for (int share = 0; share < m_fetch_shares.size(); share++)
+        enqueueNextShareRequest(share);
+}
+
+void
+CacheRecorder::fetchRequestDone(Sequencer *seq)
+{
+    if (!m_parallel_fetch) {
+        enqueueNextFetchRequest();
+        return;
+    }
+
+    for (int share = 0; share < m_fetch_shares.size(); share++) {
+        FetchShare &fs = m_fetch_shares[share];
+        if (fs.seq == seq) {
+            assert(fs.outstanding > 0);
+            if (--fs.outstanding == 0) {
+                FetchRecord &fr = m_fetch_records[fs.current];
+                fr.done = true;
+                enqueueNextShareRequest(share);
+                // let the share waiting for this line go ahead
+                if (fr.waiter != -1)
+                    enqueueNextShareRequest(fr.waiter);
+            }
+            return;
+        }
+    }
+    panic("Warmup request completed by an unknown sequencer\n");
+}
+
+uint64_t
+CacheRecorder::checkRestoredRecords(const CacheRecorder &restored) const
+{
+    if (m_block_size_bytes != RubySystem::getBlockSizeBytes()) {
+        warn("Cannot check a warmup from a trace recorded with %d-byte "
+             "blocks\n", m_block_size_bytes);
+        return 0;
+    }
+
+    // Index the restored blocks by controller and address
+    std::map<std::pair<int, Addr>, const TraceRecord *> restored_blocks;
+    for (auto rec : restored.m_records) {
+        restored_blocks[std::make_pair(rec->m_cntrl_id,
+                                       rec->m_data_address)] = rec;
+    }
+
+    uint64_t mismatches = 0;
+    uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    for (uint64_t offset = 0; offset < m_uncompressed_trace_size;
+         offset += record_size) {
+        const TraceRecord *rec =
+            (const TraceRecord *)(m_uncompressed_trace + offset);
+        auto it = restored_blocks.find(std::make_pair(rec->m_cntrl_id,
+                                                      rec->m_data_address));
+        if (it == restored_blocks.end()) {
+            DPRINTF(RubyCacheTrace, "Not restored: %s\n", *rec);
+            mismatches++;
+        } else if (it->second->m_type != rec->m_type) {
+            DPRINTF(RubyCacheTrace, "Restored as %s: %s\n",
+                    it->second->m_type, *rec);
+            mismatches++;
+        } else if (memcmp(it->second->m_data, rec->m_data,
+                          m_block_size_bytes) != 0) {
+            DPRINTF(RubyCacheTrace, "Restored with other data: %s\n", *rec);
+            mismatches++;
+        }
     }
+    return mismatches;
 }
 
 void
@@ -72,7 +72,8 @@ class CacheRecorder
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<Sequencer*>& SequencerMap,
-                  uint64_t block_size_bytes);
+                  uint64_t block_size_bytes,
+                  bool parallel_fetch);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
@@ -97,11 +98,69 @@ class CacheRecorder
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Start fetching the recorded contents. Serial fetches go through
+     * enqueueNextFetchRequest(). Parallel fetches split the records by
+     * sequencer and replay the shares concurrently, with one record in
+     * flight per sequencer. The recorded order is kept within a share,
+     * and across shares for the records of the same line.
+     */
+    void startFetchRequests();
+
+    /*!
+     * Called by a sequencer when one of the warmup requests it issued
+     * has completed, to issue the next one.
+     */
+    void fetchRequestDone(Sequencer *seq);
+
+    /*!
+     * Compare the recorded contents with the contents recorded from the
+     * caches after warmup, given in restored. Every recorded block should
+     * be back in its controller with the same permission and data. As a
+     * parallel replay keeps the order of the accesses to each line,
+     * this holds for it whenever it holds for a serial replay.
+     * Returns the number of recorded blocks that are not.
+     */
+    uint64_t checkRestoredRecords(const CacheRecorder &restored) const;
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /*!
+     * Issue the requests fetching one record, which takes several
+     * requests if the recorded block size is larger than the current
+     * one. Returns the number of requests issued.
+     */
+    int issueFetchRequests(TraceRecord *rec, Sequencer *seq);
+
+    /*! Issue the next record of a parallel fetch share. */
+    void enqueueNextShareRequest(int share);
+
+    /*! A record of the trace during a parallel fetch. */
+    struct FetchRecord
+    {
+        TraceRecord *rec;
+        /*! Index plus one of the previous record of the line, or 0. */
+        uint64_t prev;
+        /*! Share waiting for this record to complete, or -1. */
+        int waiter;
+        bool done;
+    };
+
+    /*! The records of one sequencer during a parallel fetch. */
+    struct FetchShare
+    {
+        Sequencer *seq;
+        /*! Indices of the records of the share, in trace order. */
+        std::vector<uint64_t> records;
+        size_t next;
+        /*! Record in flight. */
+        uint64_t current;
+        int outstanding;
+    };
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
@@ -110,6 +169,10 @@ class CacheRecorder
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+
+    bool m_parallel_fetch;
+    std::vector<FetchRecord> m_fetch_records;
+    std::vector<FetchShare> m_fetch_shares;
 };
 
 inline bool
@@ -63,6 +63,10 @@ RubyPort::RubyPort(const Params *p)
 {
     assert(m_version != -1);
 
+    // Ruby keeps the functional copy of the data in its own structures
+    // and possibly in a separate backing store
+    system->disableMemBackdoor();
+
     // create the slave ports based on the number of connected ports
     for (size_t i = 0; i < p->port_slave_connection_count; ++i) {
         slave_ports.push_back(new MemSlavePort(csprintf("%s.slave%d", name(),
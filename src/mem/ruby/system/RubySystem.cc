@@ -58,13 +58,15 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params *p)
     : ClockedObject(p), m_access_backing_store(p->access_backing_store),
-      m_cache_recorder(NULL)
+      m_warmup_parallel(p->warmup_parallel),
+      m_warmup_check(p->warmup_check), m_cache_recorder(NULL)
 {
     m_randomization = p->randomization;
 
     m_block_size_bytes = p->block_size_bytes;
     assert(isPowerOf2(m_block_size_bytes));
     m_block_size_bits = floorLog2(m_block_size_bytes);
+    DataBlock::setBlockSizeBytes(m_block_size_bytes);
     m_memory_size_bits = p->memory_size_bits;
 
     // Resize to the size of different machine types
@@ -128,7 +130,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         sequencer_map, block_size_bytes);
+                                         sequencer_map, block_size_bytes,
+                                         m_warmup_parallel);
 }
 
 void
@@ -362,6 +365,9 @@ RubySystem::startup()
         enqueueRubyEvent(curTick());
         simulate();
 
+        if (m_warmup_check)
+            checkWarmup();
+
         delete m_cache_recorder;
         m_cache_recorder = NULL;
         m_systems_to_warmup--;
@@ -379,11 +385,28 @@ RubySystem::startup()
     resetStats();
 }
 
+void
+RubySystem::checkWarmup()
+{
+    CacheRecorder restored;
+    for (int cntrl = 0; cntrl < m_abs_cntrl_vec.size(); cntrl++) {
+        m_abs_cntrl_vec[cntrl]->recordCacheTrace(cntrl, &restored);
+    }
+
+    uint64_t mismatches = m_cache_recorder->checkRestoredRecords(restored);
+    if (mismatches) {
+        warn("%s: %d recorded cache blocks were not restored as recorded, "
+             "see the RubyCacheTrace debug flag\n", name(), mismatches);
+    } else {
+        inform("%s: all recorded cache blocks were restored\n", name());
+    }
+}
+
 void
 RubySystem::RubyEvent::process()
 {
     if (RubySystem::getWarmupEnabled()) {
-        m_ruby_system->m_cache_recorder->enqueueNextFetchRequest();
+        m_ruby_system->m_cache_recorder->startFetchRequests();
     } else if (RubySystem::getCooldownEnabled()) {
         m_ruby_system->m_cache_recorder->enqueueNextFlushRequest();
     }
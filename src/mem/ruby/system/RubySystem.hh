@@ -121,6 +121,9 @@ class RubySystem : public ClockedObject
                            uint64_t cache_trace_size,
                            uint64_t block_size_bytes);
 
+    // Check that the caches hold the contents recorded in the trace
+    void checkWarmup();
+
     static void readCompressedTrace(std::string filename,
                                     uint8_t *&raw_data,
                                     uint64_t &uncompressed_trace_size);
@@ -139,6 +142,8 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_warmup_parallel;
+    const bool m_warmup_check;
 
     Network* m_network;
     std::vector<AbstractController *> m_abs_cntrl_vec;
@@ -46,6 +46,13 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    # Cache warmup on checkpoint restore
+    warmup_parallel = Param.Bool(False, "replay the cache trace of each "
+        "sequencer concurrently, keeping the order of the accesses to "
+        "each line, instead of one request at a time")
+    warmup_check = Param.Bool(False, "check after warmup that the caches "
+        "hold the recorded blocks with the recorded permissions")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
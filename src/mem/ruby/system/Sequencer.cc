@@ -485,7 +485,7 @@ Sequencer::hitCallback(SequencerRequest* srequest, DataBlock& data,
         assert(pkt->req);
         delete pkt->req;
         delete pkt;
-        rs->m_cache_recorder->enqueueNextFetchRequest();
+        rs->m_cache_recorder->fetchRequestDone(this);
     } else if (RubySystem::getCooldownEnabled()) {
         delete pkt;
         rs->m_cache_recorder->enqueueNextFlushRequest();
@@ -56,7 +56,8 @@ using namespace TheISA;
 
 SETranslatingPortProxy::SETranslatingPortProxy(MasterPort& port, Process *p,
                                            AllocType alloc)
-    : PortProxy(port, p->system->cacheLineSize()), pTable(p->pTable),
+    : PortProxy(port, p->system->cacheLineSize(),
+                &p->system->getPhysMem()), pTable(p->pTable),
       process(p), allocating(alloc)
 { }
 
@@ -53,7 +53,7 @@ SimpleMemory::SimpleMemory(const SimpleMemoryParams* p) :
     port(name() + ".port", *this), latency(p->latency),
     latency_var(p->latency_var), bandwidth(p->bandwidth), isBusy(false),
     retryReq(false), retryResp(false),
-    releaseEvent(this), dequeueEvent(this)
+    releaseEvent(this), accessEvent(this), dequeueEvent(this)
 {
 }
 
@@ -96,6 +96,30 @@ SimpleMemory::recvFunctional(PacketPtr pkt)
 
 bool
 SimpleMemory::recvTimingReq(PacketPtr pkt)
+{
+    return recvTimingReq(pkt, curTick());
+}
+
+unsigned
+SimpleMemory::recvTimingReqBatch(const PacketBatch& batch)
+{
+    unsigned accepted = 0;
+    for (const auto& p : batch) {
+        // a packet that is not yet due, and would find us busy when
+        // it is, is left for the master to send again at that point,
+        // so that the refusal and retry happen exactly as they would
+        // without batching
+        if (p.when > curTick() && (retryReq || isBusyAt(p.when)))
+            break;
+        if (!recvTimingReq(p.pkt, std::max(p.when, curTick())))
+            break;
+        ++accepted;
+    }
+    return accepted;
+}
+
+bool
+SimpleMemory::recvTimingReq(PacketPtr pkt, Tick when)
 {
     /// @todo temporary hack to deal with memory corruption issues until
     /// 4-phase transactions are complete
@@ -119,7 +143,7 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
 
     // if we are busy with a read or write, remember that we have to
     // retry
-    if (isBusy) {
+    if (isBusyAt(when)) {
         retryReq = true;
         return false;
     }
@@ -144,11 +168,31 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
         // to avoid extra events being scheduled for (infinitely) fast
         // memories
         if (duration != 0) {
-            schedule(releaseEvent, curTick() + duration);
+            // a packet of a batch may arrive after a release that is
+            // still pending, in which case the release moves on
+            reschedule(releaseEvent, when + duration, true);
             isBusy = true;
         }
     }
 
+    // a packet accepted ahead of time is only accessed when it is
+    // due, so that nothing sees its effect any earlier than if it
+    // arrived on its own
+    if (when > curTick()) {
+        assert(accessQueue.empty() || accessQueue.back().tick <= when);
+        accessQueue.emplace_back(pkt, when);
+        if (!accessEvent.scheduled())
+            schedule(accessEvent, when);
+    } else {
+        accessAndRespond(pkt);
+    }
+
+    return true;
+}
+
+void
+SimpleMemory::accessAndRespond(PacketPtr pkt)
+{
     // go ahead and deal with the packet and put the response in the
     // queue if there is one
     bool needsResponse = pkt->needsResponse();
@@ -167,8 +211,28 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
     } else {
         pendingDelete.push_back(pkt);
     }
+}
 
-    return true;
+void
+SimpleMemory::accessDue()
+{
+    assert(!accessQueue.empty());
+
+    // packets of a batch are due at distinct ticks, but several
+    // batches may have been accepted for the same one
+    while (!accessQueue.empty() && accessQueue.front().tick <= curTick()) {
+        PacketPtr pkt = accessQueue.front().pkt;
+        accessQueue.pop_front();
+        accessAndRespond(pkt);
+    }
+
+    if (!accessQueue.empty()) {
+        schedule(accessEvent, accessQueue.front().tick);
+    } else if (packetQueue.empty() &&
+               drainState() == DrainState::Draining) {
+        DPRINTF(Drain, "Draining of SimpleMemory complete\n");
+        signalDrainDone();
+    }
 }
 
 void
@@ -200,7 +264,8 @@ SimpleMemory::dequeue()
             // already have an event scheduled, so use re-schedule
             reschedule(dequeueEvent,
                        std::max(packetQueue.front().tick, curTick()), true);
-        } else if (drainState() == DrainState::Draining) {
+        } else if (accessQueue.empty() &&
+                   drainState() == DrainState::Draining) {
             DPRINTF(Drain, "Draining of SimpleMemory complete\n");
             signalDrainDone();
         }
@@ -235,7 +300,7 @@ SimpleMemory::getSlavePort(const std::string &if_name, PortID idx)
 DrainState
 SimpleMemory::drain()
 {
-    if (!packetQueue.empty()) {
+    if (!packetQueue.empty() || !accessQueue.empty()) {
         DPRINTF(Drain, "SimpleMemory Queue has requests, waiting to drain\n");
         return DrainState::Draining;
     } else {
@@ -274,6 +339,12 @@ SimpleMemory::MemoryPort::recvTimingReq(PacketPtr pkt)
     return memory.recvTimingReq(pkt);
 }
 
+unsigned
+SimpleMemory::MemoryPort::recvTimingReqBatch(const PacketBatch& batch)
+{
+    return memory.recvTimingReqBatch(batch);
+}
+
 void
 SimpleMemory::MemoryPort::recvRespRetry()
 {
@@ -101,10 +101,14 @@ class SimpleMemory : public AbstractMemory
 
         bool recvTimingReq(PacketPtr pkt);
 
+        unsigned recvTimingReqBatch(const PacketBatch& batch);
+
         void recvRespRetry();
 
         AddrRangeList getAddrRanges() const;
 
+        bool acceptsTimingReqBatch() const { return true; }
+
     };
 
     MemoryPort port;
@@ -127,6 +131,12 @@ class SimpleMemory : public AbstractMemory
      */
     std::deque<DeferredPacket> packetQueue;
 
+    /**
+     * Requests accepted ahead of time as part of a batch, along with
+     * the tick at which they are due and their data is accessed.
+     */
+    std::deque<DeferredPacket> accessQueue;
+
     /**
      * Bandwidth in ticks per byte. The regulation affects the
      * acceptance rate of requests and the queueing takes place after
@@ -160,6 +170,27 @@ class SimpleMemory : public AbstractMemory
 
     EventWrapper<SimpleMemory, &SimpleMemory::release> releaseEvent;
 
+    /**
+     * Determine if a request arriving at the given tick finds us
+     * busy, assuming that the release scheduled for the same tick
+     * has not happened yet.
+     */
+    bool isBusyAt(Tick when) const
+    { return isBusy && when <= releaseEvent.when(); }
+
+    /**
+     * Access the data of a request that is due, and queue the
+     * response if there is one.
+     */
+    void accessAndRespond(PacketPtr pkt);
+
+    /**
+     * Access the requests of the access queue that are now due.
+     */
+    void accessDue();
+
+    EventWrapper<SimpleMemory, &SimpleMemory::accessDue> accessEvent;
+
     /**
      * Dequeue a packet from our internal packet queue and move it to
      * the port where it will be sent as soon as possible.
@@ -199,6 +230,21 @@ class SimpleMemory : public AbstractMemory
 
     bool recvTimingReq(PacketPtr pkt);
 
+    /**
+     * Accept the packets of a batch as if each of them arrived on its
+     * own at the tick it is due, and take all of them that would have
+     * been accepted at that point. The data of a packet accepted
+     * ahead of time is accessed when the packet is due, so neither
+     * functional accesses nor the memory backdoor see it earlier.
+     */
+    unsigned recvTimingReqBatch(const PacketBatch& batch);
+
+    /**
+     * Handle a timing request that arrives at the given tick, which
+     * is the current tick unless the request is part of a batch.
+     */
+    bool recvTimingReq(PacketPtr pkt, Tick when);
+
     void recvRespRetry();
 
 };
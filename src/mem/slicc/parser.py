@@ -38,13 +38,21 @@ import slicc.util as util
 from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
-    def __init__(self, filename, base_dir, verbose=False, traceback=False, **kwargs):
+    def __init__(self, filename, base_dir, verbose=False, traceback=False,
+                 table_dir=None, **kwargs):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
+        # Keep the generated parse tables out of the current directory,
+        # either next to the generated code or not at all
+        if table_dir is not None:
+            self.setupParserFactory(outputdir=table_dir)
+        else:
+            self.setupParserFactory(write_tables=0)
+
         try:
             self.decl_list = self.parse_file(filename, **kwargs)
         except ParseError, e:
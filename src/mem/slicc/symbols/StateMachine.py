@@ -205,11 +205,76 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    # Actions whose generated code is at most this many lines are
+    # declared inline so that they disappear into doTransitionWorker.
+    inline_action_lines = 8
+
+    def actionSpecifier(self, action):
+        '''Return the specifier an action is declared with'''
+        if "c_code" in action and \
+           len(action["c_code"].splitlines()) <= self.inline_action_lines:
+            return "inline "
+        return ""
+
+    def actionParams(self):
+        '''Return the parameter list shared by all actions'''
+        params = []
+        if self.TBEType != None:
+            params.append("%s*& m_tbe_ptr" % self.TBEType.c_ident)
+        if self.EntryType != None:
+            params.append("%s*& m_cache_entry_ptr" % self.EntryType.c_ident)
+        params.append("Addr addr")
+        return ", ".join(params)
+
+    def actionArgs(self):
+        '''Return the arguments passed to every action'''
+        args = []
+        if self.TBEType != None:
+            args.append("m_tbe_ptr")
+        if self.EntryType != None:
+            args.append("m_cache_entry_ptr")
+        args.append("addr")
+        return ", ".join(args)
+
+    def printActions(self, code):
+        '''Output the definitions of the actions'''
+        c_ident = "%s_Controller" % self.ident
+        for action in self.actions.itervalues():
+            if "c_code" not in action:
+                continue
+
+            spec = self.actionSpecifier(action)
+            code('''
+/** \\brief ${{action.desc}} */
+${spec}void
+$c_ident::${{action.ident}}(${{self.actionParams()}})
+{
+    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
+''')
+            if self.TBEType != None and self.EntryType != None:
+                code('''
+    try {
+       ${{action["c_code"]}}
+    } catch (const RejectException & e) {
+       fatal("Error in action ${{self.ident}}:${{action.ident}}: "
+             "executed a peek statement with the wrong message "
+             "type specified. ");
+    }
+''')
+            else:
+                code('''
+    ${{action["c_code"]}}
+''')
+            code('''
+}
+
+''')
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
         self.printControllerCC(path, includes)
-        self.printCSwitch(path)
+        self.printCSwitch(path, includes)
         self.printCWakeup(path, includes)
 
     def printControllerPython(self, path):
@@ -342,22 +407,22 @@ TransitionResult doTransition(${ident}_Event event,
         code('''
                               Addr addr);
 
-TransitionResult doTransitionWorker(${ident}_Event event,
-                                    ${ident}_State state,
-                                    ${ident}_State& next_state,
+inline TransitionResult doTransitionWorker(${ident}_Event event,
+                                           ${ident}_State state,
+                                           ${ident}_State& next_state,
 ''')
 
         if self.TBEType != None:
             code('''
-                                    ${{self.TBEType.c_ident}}*& m_tbe_ptr,
+                                           ${{self.TBEType.c_ident}}*& m_tbe_ptr,
 ''')
         if self.EntryType != None:
             code('''
-                                    ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
+                                           ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
 ''')
 
         code('''
-                                    Addr addr);
+                                           Addr addr);
 
 int m_counters[${ident}_State_NUM][${ident}_Event_NUM];
 int m_event_counters[${ident}_Event_NUM];
@@ -396,26 +461,10 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 
 // Actions
 ''')
-        if self.TBEType != None and self.EntryType != None:
-            for action in self.actions.itervalues():
-                code('/** \\brief ${{action.desc}} */')
-                code('void ${{action.ident}}(${{self.TBEType.c_ident}}*& '
-                     'm_tbe_ptr, ${{self.EntryType.c_ident}}*& '
-                     'm_cache_entry_ptr, Addr addr);')
-        elif self.TBEType != None:
-            for action in self.actions.itervalues():
-                code('/** \\brief ${{action.desc}} */')
-                code('void ${{action.ident}}(${{self.TBEType.c_ident}}*& '
-                     'm_tbe_ptr, Addr addr);')
-        elif self.EntryType != None:
-            for action in self.actions.itervalues():
-                code('/** \\brief ${{action.desc}} */')
-                code('void ${{action.ident}}(${{self.EntryType.c_ident}}*& '
-                     'm_cache_entry_ptr, Addr addr);')
-        else:
-            for action in self.actions.itervalues():
-                code('/** \\brief ${{action.desc}} */')
-                code('void ${{action.ident}}(Addr addr);')
+        for action in self.actions.itervalues():
+            spec = self.actionSpecifier(action)
+            code('/** \\brief ${{action.desc}} */')
+            code('${spec}void ${{action.ident}}(${{self.actionParams()}});')
 
         # the controller internal variables
         code('''
@@ -876,75 +925,8 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
         code.dedent()
         code('''
 }
-
-// Actions
-''')
-        if self.TBEType != None and self.EntryType != None:
-            for action in self.actions.itervalues():
-                if "c_code" not in action:
-                 continue
-
-                code('''
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    try {
-       ${{action["c_code"]}}
-    } catch (const RejectException & e) {
-       fatal("Error in action ${{ident}}:${{action.ident}}: "
-             "executed a peek statement with the wrong message "
-             "type specified. ");
-    }
-}
-
-''')
-        elif self.TBEType != None:
-            for action in self.actions.itervalues():
-                if "c_code" not in action:
-                 continue
-
-                code('''
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
-
 ''')
-        elif self.EntryType != None:
-            for action in self.actions.itervalues():
-                if "c_code" not in action:
-                 continue
-
-                code('''
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
 
-''')
-        else:
-            for action in self.actions.itervalues():
-                if "c_code" not in action:
-                 continue
-
-                code('''
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
-
-''')
         for func in self.functions:
             code(func.generateCode())
 
@@ -1099,8 +1081,8 @@ ${ident}_Controller::wakeup()
 
         code.write(path, "%s_Wakeup.cc" % self.ident)
 
-    def printCSwitch(self, path):
-        '''Output switch statement for transition table'''
+    def printCSwitch(self, path, includes):
+        '''Output the actions and the transition table'''
 
         code = self.symtab.codeFormatter()
         ident = self.ident
@@ -1110,22 +1092,189 @@ ${ident}_Controller::wakeup()
 // ${ident}: ${{self.short}}
 
 #include <cassert>
+#include <sstream>
+#include <string>
+#include <typeinfo>
 
+#include "base/cprintf.hh"
 #include "base/misc.hh"
 #include "base/trace.hh"
 #include "debug/ProtocolTrace.hh"
-#include "debug/RubyGenerated.hh"
+''')
+        for f in sorted(self.debug_flags):
+            code('#include "debug/${{f}}.hh"')
+        code('''
 #include "mem/protocol/${ident}_Controller.hh"
 #include "mem/protocol/${ident}_Event.hh"
 #include "mem/protocol/${ident}_State.hh"
 #include "mem/protocol/Types.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
-#define HASH_FUN(state, event)  ((int(state)*${ident}_Event_NUM)+int(event))
+''')
+        for include_path in includes:
+            code('#include "${{include_path}}"')
+
+        code('''
+
+using namespace std;
 
 #define GET_TRANSITION_COMMENT() (${ident}_transitionComment.str())
 #define CLEAR_TRANSITION_COMMENT() (${ident}_transitionComment.str(""))
 
+#ifndef NDEBUG
+#define APPEND_TRANSITION_COMMENT(str) (${ident}_transitionComment << str)
+#else
+#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
+#endif
+
+// Actions
+''')
+        # The actions live in the same file as doTransitionWorker, their
+        # only caller, so that they can be inlined into it.
+        self.printActions(code)
+
+        # This map will allow suppress generating duplicate code
+        cases = orderdict()
+
+        for trans in self.transitions:
+
+            case = self.symtab.codeFormatter()
+            # Only set next_state if it changes
+            if trans.state != trans.nextState:
+                if trans.nextState.isWildcard():
+                    # When * is encountered as an end state of a transition,
+                    # the next state is determined by calling the
+                    # machine-specific getNextState function. The next state
+                    # is determined before any actions of the transition
+                    # execute, and therefore the next state calculation cannot
+                    # depend on any of the transitionactions.
+                    case('next_state = getNextState(addr);')
+                else:
+                    ns_ident = trans.nextState.ident
+                    case('next_state = ${ident}_State_${ns_ident};')
+
+            actions = trans.actions
+            request_types = trans.request_types
+
+            # Check for resources
+            case_sorter = []
+            res = trans.resources
+            for key,val in res.iteritems():
+                val = '''
+if (!%s.areNSlotsAvailable(%s, clockEdge()))
+    return TransitionResult_ResourceStall;
+''' % (key.code, val)
+                case_sorter.append(val)
+
+            # Check all of the request_types for resource constraints
+            for request_type in request_types:
+                val = '''
+if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    return TransitionResult_ResourceStall;
+}
+''' % (self.ident, request_type.ident)
+                case_sorter.append(val)
+
+            # Emit the code sequences in a sorted order.  This makes the
+            # output deterministic (without this the output order can vary
+            # since Map's keys() on a vector of pointers is not deterministic
+            for c in sorted(case_sorter):
+                case("$c")
+
+            # Record access types for this transition
+            for request_type in request_types:
+                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
+
+            # Figure out if we stall
+            stall = False
+            for action in actions:
+                if action.ident == "z_stall":
+                    stall = True
+                    break
+
+            if stall:
+                case('return TransitionResult_ProtocolStall;')
+            else:
+                args = self.actionArgs()
+                for action in actions:
+                    case('${{action.ident}}($args);')
+                case('return TransitionResult_Valid;')
+
+            case = str(case)
+
+            # Look to see if this transition code is unique.
+            if case not in cases:
+                cases[case] = []
+
+            cases[case].append(trans)
+
+        # Number the unique code blocks from 1 and build a dense
+        # state x event table of block numbers, 0 marking the invalid
+        # transitions. doTransitionWorker switches over the block number,
+        # which gives a dense jump table however sparse the transitions.
+        block_ids = {}
+        for i,case in enumerate(cases.iterkeys()):
+            block_ids[case] = i + 1
+        assert len(block_ids) < 65536
+
+        trans_ids = {}
+        for case,transitions in cases.iteritems():
+            for trans in transitions:
+                trans_ids[(trans.state, trans.event)] = block_ids[case]
+
+        code('''
+static const uint16_t ${ident}_transitionTable[${ident}_State_NUM][${ident}_Event_NUM] = {
+''')
+        code.indent()
+        for state in self.states.itervalues():
+            row = ", ".join([ str(trans_ids.get((state, event), 0))
+                              for event in self.events.itervalues() ])
+            code('// ${{state.ident}}')
+            code('{ $row },')
+        code.dedent()
+        code('''
+};
+
+TransitionResult
+${ident}_Controller::doTransitionWorker(${ident}_Event event,
+                                        ${ident}_State state,
+                                        ${ident}_State& next_state,
+''')
+
+        if self.TBEType != None:
+            code('''
+                                        ${{self.TBEType.c_ident}}*& m_tbe_ptr,
+''')
+        if self.EntryType != None:
+            code('''
+                                        ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
+''')
+        code('''
+                                        Addr addr)
+{
+    assert(state < ${ident}_State_NUM && event < ${ident}_Event_NUM);
+
+    switch (${ident}_transitionTable[state][event]) {
+''')
+
+        # Walk through all of the unique code blocks and spit out the
+        # corresponding case statement elements
+        for case,transitions in cases.iteritems():
+            for trans in transitions:
+                code('  // ${{trans.state.ident}}, ${{trans.event.ident}}')
+            code('  case ${{block_ids[case]}}:')
+            code('    $case\n')
+
+        code('''
+      default:
+        panic("Invalid transition\\n"
+              "%s time: %d addr: %s event: %s state: %s\\n",
+              name(), curCycle(), addr, event, state);
+    }
+
+    return TransitionResult_Valid;
+}
+
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
 ''')
@@ -1224,131 +1373,6 @@ return result;
         code.dedent()
         code('''
 }
-
-TransitionResult
-${ident}_Controller::doTransitionWorker(${ident}_Event event,
-                                        ${ident}_State state,
-                                        ${ident}_State& next_state,
-''')
-
-        if self.TBEType != None:
-            code('''
-                                        ${{self.TBEType.c_ident}}*& m_tbe_ptr,
-''')
-        if self.EntryType != None:
-                  code('''
-                                        ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
-''')
-        code('''
-                                        Addr addr)
-{
-    switch(HASH_FUN(state, event)) {
-''')
-
-        # This map will allow suppress generating duplicate code
-        cases = orderdict()
-
-        for trans in self.transitions:
-            case_string = "%s_State_%s, %s_Event_%s" % \
-                (self.ident, trans.state.ident, self.ident, trans.event.ident)
-
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case('next_state = getNextState(addr);')
-                else:
-                    ns_ident = trans.nextState.ident
-                    case('next_state = ${ident}_State_${ns_ident};')
-
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key,val in res.iteritems():
-                val = '''
-if (!%s.areNSlotsAvailable(%s, clockEdge()))
-    return TransitionResult_ResourceStall;
-''' % (key.code, val)
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = '''
-if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
-    return TransitionResult_ResourceStall;
-}
-''' % (self.ident, request_type.ident)
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
-
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
-                case('return TransitionResult_ProtocolStall;')
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
-                elif self.TBEType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, addr);')
-                elif self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_cache_entry_ptr, addr);')
-                else:
-                    for action in actions:
-                        case('${{action.ident}}(addr);')
-                case('return TransitionResult_Valid;')
-
-            case = str(case)
-
-            # Look to see if this transition code is unique.
-            if case not in cases:
-                cases[case] = []
-
-            cases[case].append(case_string)
-
-        # Walk through all of the unique code blocks and spit out the
-        # corresponding case statement elements
-        for case,transitions in cases.iteritems():
-            # Iterative over all the multiple transitions that share
-            # the same code
-            for trans in transitions:
-                code('  case HASH_FUN($trans):')
-            code('    $case\n')
-
-        code('''
-      default:
-        panic("Invalid transition\\n"
-              "%s time: %d addr: %s event: %s state: %s\\n",
-              name(), curCycle(), addr, event, state);
-    }
-
-    return TransitionResult_Valid;
-}
 ''')
         code.write(path, "%s_Transitions.cc" % self.ident)
 
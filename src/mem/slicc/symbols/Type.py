@@ -232,19 +232,38 @@ $klass ${{self.c_ident}}$parent
             code.dedent()
         code('}')
 
+        # Members declared in this class are copy constructed in the
+        # initializer list rather than default constructed and then
+        # assigned, which for data blocks would clear the line only to
+        # overwrite it. Abstract members live in the interface and are
+        # assigned in the constructor body.
+        def ctorInits(base, src):
+            inits = []
+            if base:
+                inits.append(base)
+            for dm in self.data_members.values():
+                if "abstract" not in dm:
+                    inits.append('m_%s(%s%s)' % (dm.ident, src, dm.ident))
+            if inits:
+                init_list = ', '.join(inits)
+                code('    : $init_list')
+
         # ******** Copy constructor ********
         if not self.isGlobal:
             code('${{self.c_ident}}(const ${{self.c_ident}}&other)')
 
             # Call superclass constructor
+            base = None
             if "interface" in self:
-                code('    : ${{self["interface"]}}(other)')
+                base = '%s(other)' % self["interface"]
+            ctorInits(base, 'other.m_')
 
             code('{')
             code.indent()
 
             for dm in self.data_members.values():
-                code('m_${{dm.ident}} = other.m_${{dm.ident}};')
+                if "abstract" in dm:
+                    code('m_${{dm.ident}} = other.m_${{dm.ident}};')
 
             code.dedent()
             code('}')
@@ -261,16 +280,19 @@ $klass ${{self.c_ident}}$parent
             code('${{self.c_ident}}($params)')
 
             # Call superclass constructor
+            base = None
             if "interface" in self:
                 if self.isMessage:
-                    code('    : ${{self["interface"]}}(curTime)')
+                    base = '%s(curTime)' % self["interface"]
                 else:
-                    code('    : ${{self["interface"]}}()')
+                    base = '%s()' % self["interface"]
+            ctorInits(base, 'local_')
 
             code('{')
             code.indent()
             for dm in self.data_members.values():
-                code('m_${{dm.ident}} = local_${{dm.ident}};')
+                if "abstract" in dm:
+                    code('m_${{dm.ident}} = local_${{dm.ident}};')
 
             code.dedent()
             code('}')
@@ -53,12 +53,40 @@ SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
 {
     SnoopItem& sf_item = sf_it->second;
     if (!(sf_item.requested | sf_item.holder)) {
+        bloomRemove(sf_it->first);
         cachedLocations.erase(sf_it);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
 }
 
+SnoopFilter::SnoopItem&
+SnoopFilter::findOrCreate(Addr line_addr)
+{
+    auto ret = cachedLocations.emplace(line_addr, SnoopItem());
+    if (ret.second)
+        bloomInsert(line_addr);
+    return ret.first->second;
+}
+
+SnoopFilter::SnoopFilterCache::iterator
+SnoopFilter::find(Addr line_addr)
+{
+    if (bloomCounters.empty())
+        return cachedLocations.find(line_addr);
+
+    bloomLookups++;
+    if (!bloomMayContain(line_addr)) {
+        bloomFiltered++;
+        return cachedLocations.end();
+    }
+
+    auto sf_it = cachedLocations.find(line_addr);
+    if (sf_it == cachedLocations.end())
+        bloomFalsePositives++;
+    return sf_it;
+}
+
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 {
@@ -70,7 +98,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
     bool allocate = !cpkt->req->isUncacheable() && slave_port.isSnooping();
     Addr line_addr = cpkt->getBlockAddr(linesize);
     SnoopMask req_port = portToMask(slave_port);
-    reqLookupResult = cachedLocations.find(line_addr);
+    reqLookupResult = find(line_addr);
     bool is_hit = (reqLookupResult != cachedLocations.end());
 
     // If the snoop filter has no entry, and we should not allocate,
@@ -80,8 +108,10 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
         return snoopDown(lookupLatency);
 
     // If no hit in snoop filter create a new element and update iterator
-    if (!is_hit)
+    if (!is_hit) {
         reqLookupResult = cachedLocations.emplace(line_addr, SnoopItem()).first;
+        bloomInsert(line_addr);
+    }
     SnoopItem& sf_item = reqLookupResult->second;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
@@ -175,7 +205,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     assert(cpkt->isRequest());
 
     Addr line_addr = cpkt->getBlockAddr(linesize);
-    auto sf_it = cachedLocations.find(line_addr);
+    auto sf_it = find(line_addr);
     bool is_hit = (sf_it != cachedLocations.end());
 
     panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
@@ -244,7 +274,7 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     Addr line_addr = cpkt->getBlockAddr(linesize);
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem& sf_item = findOrCreate(line_addr);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -290,7 +320,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     assert(cpkt->memInhibitAsserted());
 
     Addr line_addr = cpkt->getBlockAddr(linesize);
-    auto sf_it = cachedLocations.find(line_addr);
+    auto sf_it = find(line_addr);
     bool is_hit = sf_it != cachedLocations.end();
 
     // Nothing to do if it is not a hit
@@ -334,7 +364,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
 
     Addr line_addr = cpkt->getBlockAddr(linesize);
     SnoopMask slave_mask = portToMask(slave_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem& sf_item = findOrCreate(line_addr);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -384,6 +414,34 @@ SnoopFilter::regStats()
         .name(name() + ".hit_multi_snoops")
         .desc("Number of snoops hitting in the snoop filter with multiple "\
               "(>1) holders of the requested data.");
+
+    bloomLookups
+        .name(name() + ".bloom_lookups")
+        .desc("Number of lookups checked against the Bloom filter.")
+        .flags(Stats::nozero);
+
+    bloomFiltered
+        .name(name() + ".bloom_filtered")
+        .desc("Number of lookups the Bloom filter answered as misses.")
+        .flags(Stats::nozero);
+
+    bloomFalsePositives
+        .name(name() + ".bloom_false_positives")
+        .desc("Number of lookups passed on by the Bloom filter that missed.")
+        .flags(Stats::nozero);
+
+    bloomFilterRate
+        .name(name() + ".bloom_filter_rate")
+        .desc("Fraction of lookups answered by the Bloom filter alone.")
+        .flags(Stats::nozero);
+    bloomFilterRate = bloomFiltered / bloomLookups;
+
+    bloomFalsePositiveRate
+        .name(name() + ".bloom_false_positive_rate")
+        .desc("Fraction of the misses the Bloom filter did not catch.")
+        .flags(Stats::nozero);
+    bloomFalsePositiveRate =
+        bloomFalsePositives / (bloomFiltered + bloomFalsePositives);
 }
 
 SnoopFilter *
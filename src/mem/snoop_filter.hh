@@ -47,7 +47,9 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
@@ -91,8 +93,17 @@ class SnoopFilter : public SimObject {
     SnoopFilter (const SnoopFilterParams *p) :
         SimObject(p), reqLookupResult(cachedLocations.end()), retryItem{0, 0},
         linesize(p->system->cacheLineSize()), lookupLatency(p->lookup_latency),
-        maxEntryCount(p->max_capacity / p->system->cacheLineSize())
+        maxEntryCount(p->max_capacity / p->system->cacheLineSize()),
+        bloomCounters(p->bloom_filter_entries, 0),
+        bloomShift(p->bloom_filter_entries ?
+                   64 - floorLog2(p->bloom_filter_entries) : 0),
+        lineShift(floorLog2(linesize))
     {
+        fatal_if(p->bloom_filter_entries &&
+                 (!isPowerOf2(p->bloom_filter_entries) ||
+                  p->bloom_filter_entries < 2),
+                 "%s: bloom_filter_entries must be a power of two\n",
+                 name());
     }
 
     /**
@@ -258,6 +269,29 @@ class SnoopFilter : public SimObject {
      */
     void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
 
+    /**
+     * Find the item of a line, or create an empty one, keeping the
+     * Bloom filter in sync with the hash map.
+     */
+    SnoopItem& findOrCreate(Addr line_addr);
+
+    /**
+     * Look up a line in the hash map, unless the Bloom filter already
+     * knows that it is not tracked.
+     *
+     * @return An iterator to the item, or the end of the map.
+     */
+    SnoopFilterCache::iterator find(Addr line_addr);
+
+    /** Index of one of the two counters of a line in the Bloom filter */
+    unsigned bloomIndex(Addr line_addr, int hash) const;
+    /** Count a line that has been added to the hash map */
+    void bloomInsert(Addr line_addr);
+    /** Uncount a line that has been removed from the hash map */
+    void bloomRemove(Addr line_addr);
+    /** False if the line is certainly not in the hash map */
+    bool bloomMayContain(Addr line_addr) const;
+
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
     /**
@@ -282,6 +316,20 @@ class SnoopFilter : public SimObject {
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
 
+    /**
+     * Optional counting Bloom filter in front of the hash map. Every
+     * tracked line increments two counters, so a lookup that finds
+     * either of its counters at zero is a definite miss and does not
+     * need to probe the map. Counters that reach their maximum stay
+     * there, so that the filter never reports a false negative. Empty
+     * if the filter is disabled.
+     */
+    std::vector<uint16_t> bloomCounters;
+    /** Shift turning a 64-bit hash into a counter index */
+    const unsigned bloomShift;
+    /** log2 of the cache line size */
+    const unsigned lineShift;
+
     /** Statistics */
     Stats::Scalar totRequests;
     Stats::Scalar hitSingleRequests;
@@ -290,6 +338,12 @@ class SnoopFilter : public SimObject {
     Stats::Scalar totSnoops;
     Stats::Scalar hitSingleSnoops;
     Stats::Scalar hitMultiSnoops;
+
+    Stats::Scalar bloomLookups;
+    Stats::Scalar bloomFiltered;
+    Stats::Scalar bloomFalsePositives;
+    Stats::Formula bloomFilterRate;
+    Stats::Formula bloomFalsePositiveRate;
 };
 
 inline SnoopFilter::SnoopMask
@@ -301,6 +355,47 @@ SnoopFilter::portToMask(const SlavePort& port) const
         ((SnoopMask)1) << localSlavePortIds[port.getId()];
 }
 
+inline unsigned
+SnoopFilter::bloomIndex(Addr line_addr, int hash) const
+{
+    static const uint64_t multipliers[2] = {
+        0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL };
+    return ((line_addr >> lineShift) * multipliers[hash]) >> bloomShift;
+}
+
+inline void
+SnoopFilter::bloomInsert(Addr line_addr)
+{
+    if (bloomCounters.empty())
+        return;
+    for (int hash = 0; hash < 2; hash++) {
+        uint16_t& counter = bloomCounters[bloomIndex(line_addr, hash)];
+        if (counter != UINT16_MAX)
+            counter++;
+    }
+}
+
+inline void
+SnoopFilter::bloomRemove(Addr line_addr)
+{
+    if (bloomCounters.empty())
+        return;
+    for (int hash = 0; hash < 2; hash++) {
+        uint16_t& counter = bloomCounters[bloomIndex(line_addr, hash)];
+        assert(counter > 0);
+        if (counter != UINT16_MAX)
+            counter--;
+    }
+}
+
+inline bool
+SnoopFilter::bloomMayContain(Addr line_addr) const
+{
+    return bloomCounters.empty() ||
+        (bloomCounters[bloomIndex(line_addr, 0)] &&
+         bloomCounters[bloomIndex(line_addr, 1)]);
+}
+
 inline SnoopFilter::SnoopList
 SnoopFilter::maskToPortList(SnoopMask port_mask) const
 {
@@ -105,12 +105,12 @@ BaseXBar::getSlavePort(const std::string &if_name, PortID idx)
 }
 
 void
-BaseXBar::calcPacketTiming(PacketPtr pkt, Tick header_delay)
+BaseXBar::calcPacketTiming(PacketPtr pkt, Tick header_delay, Tick when)
 {
     // the crossbar will be called at a time that is not necessarily
     // coinciding with its own clock, so start by determining how long
     // until the next clock edge (could be zero)
-    Tick offset = clockEdge() - curTick();
+    Tick offset = clockEdgeAt(when) - when;
 
     // the header delay depends on the path through the crossbar, and
     // we therefore rely on the caller to provide the actual
@@ -142,6 +142,129 @@ BaseXBar::calcPacketTiming(PacketPtr pkt, Tick header_delay)
     // thus regulates throughput
 }
 
+bool
+BaseXBar::destAcceptsTimingReqBatch(const PacketBatch& batch)
+{
+    PortID master_port_id = findPort(batch.front().pkt->getAddr());
+    return masterPorts[master_port_id]->peerAcceptsTimingReqBatch();
+}
+
+bool
+BaseXBar::anyDestAcceptsTimingReqBatch() const
+{
+    for (const auto& m : masterPorts) {
+        if (m->peerAcceptsTimingReqBatch())
+            return true;
+    }
+    return false;
+}
+
+unsigned
+BaseXBar::forwardTimingReqBatch(const PacketBatch& batch,
+                                PortID slave_port_id,
+                                const std::vector<ReqLayer*>& req_layers)
+{
+    // determine the source port based on the id
+    SlavePort *src_port = slavePorts[slave_port_id];
+
+    // the whole batch goes to the destination of the first packet
+    const PortID master_port_id = findPort(batch.front().pkt->getAddr());
+    ReqLayer& layer = *req_layers[master_port_id];
+
+    // the first packet is due, and finds the layer like it would on
+    // its own
+    if (!layer.tryTiming(src_port)) {
+        DPRINTF(BaseXBar, "recvTimingReqBatch: src %s %s 0x%x BUSY\n",
+                src_port->name(), batch.front().pkt->cmdString(),
+                batch.front().pkt->getAddr());
+        return 0;
+    }
+
+    // a request sees the frontend and forward latency
+    const Tick xbar_delay = (frontendLatency + forwardLatency) *
+        clockPeriod();
+
+    forwardBatch.clear();
+    forwardInfo.clear();
+    for (const auto& p : batch) {
+        PacketPtr pkt = p.pkt;
+        const Tick when = std::max(p.when, curTick());
+
+        // batches only ever carry normal requests
+        assert(!pkt->isExpressSnoop() && !pkt->memInhibitAsserted());
+
+        // anything after the first packet has to be strictly in the
+        // future, find the layer idle when it is due, and go to the
+        // same place, or it is left for the source to send again
+        if (!forwardBatch.empty() &&
+            (when == curTick() || when < forwardInfo.back().finishTime ||
+             findPort(pkt->getAddr()) != master_port_id))
+            break;
+
+        ForwardedPacket info;
+        info.oldHeaderDelay = pkt->headerDelay;
+        info.size = pkt->hasData() ? pkt->getSize() : 0;
+        info.cmd = pkt->cmdToIndex();
+        info.expectResponse = pkt->needsResponse();
+
+        // set the packet header and payload delay, and determine how
+        // long the layer is busy, all as seen from the due tick
+        calcPacketTiming(pkt, xbar_delay, when);
+        info.finishTime = clockEdgeAt(when, Cycles(1)) +
+            pkt->payloadDelay;
+
+        forwardBatch.push_back(p);
+        forwardInfo.push_back(info);
+    }
+
+    DPRINTF(BaseXBar, "recvTimingReqBatch: src %s %s 0x%x, %d packets\n",
+            src_port->name(), batch.front().pkt->cmdString(),
+            batch.front().pkt->getAddr(), forwardBatch.size());
+
+    const unsigned accepted =
+        masterPorts[master_port_id]->sendTimingReqBatch(forwardBatch);
+
+    // restore the header delay of anything that was not accepted, as
+    // it is additive
+    for (unsigned i = accepted; i < forwardBatch.size(); ++i)
+        forwardBatch[i].pkt->headerDelay = forwardInfo[i].oldHeaderDelay;
+
+    if (accepted == 0) {
+        DPRINTF(BaseXBar, "recvTimingReqBatch: src %s %s 0x%x RETRY\n",
+                src_port->name(), batch.front().pkt->cmdString(),
+                batch.front().pkt->getAddr());
+
+        // occupy until the header is sent
+        layer.failedTiming(src_port, clockEdge(Cycles(1)));
+        return 0;
+    }
+
+    Tick busy_ticks = 0;
+    for (unsigned i = 0; i < accepted; ++i) {
+        const ForwardedPacket& info = forwardInfo[i];
+
+        // remember where to route the response to
+        if (info.expectResponse) {
+            RequestPtr req = forwardBatch[i].pkt->req;
+            assert(routeTo.find(req) == routeTo.end());
+            routeTo[req] = slave_port_id;
+        }
+
+        busy_ticks += info.finishTime - std::max(forwardBatch[i].when,
+                                                 curTick());
+
+        // stats updates
+        pktCount[slave_port_id][master_port_id]++;
+        pktSize[slave_port_id][master_port_id] += info.size;
+        transDist[info.cmd]++;
+    }
+
+    layer.succeededTimingBatch(forwardInfo[accepted - 1].finishTime,
+                               busy_ticks);
+
+    return accepted;
+}
+
 template <typename SrcType, typename DstType>
 BaseXBar::Layer<SrcType,DstType>::Layer(DstType& _port, BaseXBar& _xbar,
                                        const std::string& _name) :
@@ -213,6 +336,24 @@ BaseXBar::Layer<SrcType,DstType>::succeededTiming(Tick busy_time)
     occupyLayer(busy_time);
 }
 
+template <typename SrcType, typename DstType>
+void
+BaseXBar::Layer<SrcType,DstType>::succeededTimingBatch(Tick busy_time,
+                                                      Tick busy_ticks)
+{
+    // we should have gone from idle or retry to busy in the tryTiming
+    // test
+    assert(state == BUSY);
+
+    // stay busy until the last packet is done, but only account for
+    // the ticks the packets actually occupy the layer
+    xbar.schedule(releaseEvent, busy_time);
+    occupancy += busy_ticks;
+
+    DPRINTF(BaseXBar, "The crossbar layer is now busy from tick %d to %d "
+            "with a batch\n", curTick(), busy_time);
+}
+
 template <typename SrcType, typename DstType>
 void
 BaseXBar::Layer<SrcType,DstType>::failedTiming(SrcType* src_port,
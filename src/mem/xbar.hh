@@ -143,6 +143,17 @@ class BaseXBar : public MemObject
          */
         void succeededTiming(Tick busy_time);
 
+        /**
+         * Deal with a destination port accepting a batch of packets
+         * ahead of time. The layer stays occupied until the last of
+         * them is done, so that a batch is never interleaved with
+         * packets from other ports.
+         *
+         * @param busy_time Time at which the last packet is done
+         * @param busy_ticks Ticks the packets themselves occupy the layer
+         */
+        void succeededTimingBatch(Tick busy_time, Tick busy_ticks);
+
         /**
          * Deal with a destination port not accepting a packet by
          * potentially adding the source port to the retry list (if
@@ -412,8 +423,57 @@ class BaseXBar : public MemObject
      *
      * @param pkt Packet to populate with timings
      * @param header_delay Header delay to be added
+     * @param when Tick at which the packet arrives
      */
-    void calcPacketTiming(PacketPtr pkt, Tick header_delay);
+    void calcPacketTiming(PacketPtr pkt, Tick header_delay, Tick when);
+
+    void calcPacketTiming(PacketPtr pkt, Tick header_delay)
+    { calcPacketTiming(pkt, header_delay, curTick()); }
+
+    /**
+     * Forward a batch of timing requests from a slave port to the
+     * master port of the first packet, which must take batches
+     * itself. Each packet sees the crossbar as if it arrived on its
+     * own at the tick it is due, and the batch ends at the first
+     * packet that goes elsewhere, or that would find the layer still
+     * busy with the packet before it. Only the first packet is due,
+     * and it is refused exactly as it would be on its own.
+     *
+     * @param batch Packets received, the first one being due now
+     * @param slave_port_id Id of the slave port the batch came in on
+     * @param req_layers Request layers, indexed by master port id
+     *
+     * @return The number of packets accepted, from the start
+     */
+    unsigned forwardTimingReqBatch(const PacketBatch& batch,
+                                   PortID slave_port_id,
+                                   const std::vector<ReqLayer*>& req_layers);
+
+    /**
+     * Determine if the destination of a batch of timing requests
+     * takes batches itself, so that the batch can be forwarded.
+     */
+    bool destAcceptsTimingReqBatch(const PacketBatch& batch);
+
+    /** Determine if any of the destinations takes batches. */
+    bool anyDestAcceptsTimingReqBatch() const;
+
+    /**
+     * The part of a batch being forwarded, along with what we need to
+     * know about each packet once the destination has had its say.
+     */
+    PacketBatch forwardBatch;
+
+    struct ForwardedPacket
+    {
+        Tick oldHeaderDelay;
+        Tick finishTime;
+        unsigned int size;
+        unsigned int cmd;
+        bool expectResponse;
+    };
+
+    std::vector<ForwardedPacket> forwardInfo;
 
     /**
      * Remember for each of the master ports of the crossbar if we got
@@ -82,6 +82,10 @@ def parse_options():
     group("Statistics Options")
     option("--stats-file", metavar="FILE", default="stats.txt",
         help="Sets the output file for statistics [Default: %default]")
+    option("--stats-binary-file", metavar="FILE", default="",
+        help="Also write statistics in the columnar binary format to FILE")
+    option("--stats-binary-uncompressed", action="store_true",
+        help="Don't compress the records of the binary statistics file")
 
     # Configuration Options
     group("Configuration Options")
@@ -314,6 +318,9 @@ def main(*args):
 
     # set stats options
     stats.initText(options.stats_file)
+    if options.stats_binary_file:
+        stats.initBinary(options.stats_binary_file,
+                         not options.stats_binary_uncompressed)
 
     # set debugging options
     debug.setRemoteGDBPort(options.remote_gdb_port)
@@ -223,6 +223,72 @@ def checkpoint(dir):
     print "Writing checkpoint"
     internal.core.serializeAll(dir)
 
+_fork_seq = 0
+def fork(simout="%(parent)s.f%(fork_seq)i"):
+    """Fork the simulator, e.g., to simulate several samples from the
+    same point without restoring a checkpoint for each of them. The
+    memory of the parent is shared copy-on-write with the child.
+
+    The simulator is drained before forking. The child writes its
+    output (stats, traces, ...) to a new output directory named after
+    the simout template, which may refer to the output directory of
+    the parent (parent), the number of children forked so far by the
+    parent (fork_seq) and the pid of the child (pid). If stdout or
+    stderr were redirected, the child redirects them to the files of
+    the same name in its output directory.
+
+    Listening sockets, e.g., of terminals and remote GDB, can't be
+    shared with a child, so m5.disableAllListeners() must be called
+    before instantiate(). Simulators running several event queues
+    can't be forked.
+
+    Returns the pid of the child in the parent and 0 in the child,
+    like os.fork().
+    """
+    from m5 import options
+    global _fork_seq
+
+    if not internal.core.listenersDisabled():
+        raise RuntimeError, "Can't fork a simulator with listeners enabled"
+
+    drain()
+    internal.core.prepareFork()
+    sys.stdout.flush()
+    sys.stderr.flush()
+
+    pid = os.fork()
+    if pid == 0:
+        outdir = simout % { "parent" : options.outdir.rstrip('/'),
+                            "fork_seq" : _fork_seq,
+                            "pid" : os.getpid() }
+        if not os.path.isdir(outdir):
+            os.makedirs(outdir)
+        options.outdir = outdir
+        internal.core.relocateOutputDir(outdir)
+        for output in stats.outputList:
+            output.reopen()
+
+        # stdout and stderr follow the output directory if they were
+        # redirected into it
+        if options.redirect_stdout:
+            redir_fd = os.open(os.path.join(outdir, options.stdout_file),
+                               os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+            os.dup2(redir_fd, sys.stdout.fileno())
+            if not options.redirect_stderr:
+                os.dup2(redir_fd, sys.stderr.fileno())
+            os.close(redir_fd)
+
+        if options.redirect_stderr:
+            redir_fd = os.open(os.path.join(outdir, options.stderr_file),
+                               os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+            os.dup2(redir_fd, sys.stderr.fileno())
+            os.close(redir_fd)
+        _fork_seq = 0
+    else:
+        _fork_seq += 1
+
+    return pid
+
 def _changeMemoryMode(system, mode):
     if not isinstance(system, (objects.Root, objects.System)):
         raise TypeError, "Parameter of type '%s'.  Must be type %s or %s." % \
@@ -39,6 +39,12 @@ def initText(filename, desc=True):
     output = internal.stats.initText(filename, desc)
     outputList.append(output)
 
+def initBinary(filename, compress=True):
+    '''Write stats in the columnar binary format, see
+    m5/stats/binary.py for the reader.'''
+    output = internal.stats.initBinary(filename, compress)
+    outputList.append(output)
+
 def initSimStats():
     internal.stats.initSimStats()
     internal.stats.registerPythonStatsHandlers()
@@ -0,0 +1,433 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''Reader for the columnar binary statistics written by Stats::Binary
+(see src/base/stats/binary.hh).
+
+The file holds a schema record describing every stat followed by one
+data record per dump. Whole dumps can be decoded with dumps(), while
+column() only unpacks the values of a single stat from every dump:
+
+    stats = BinaryStats('m5out/stats.bin')
+    for tick, value in stats.column('system.cpu.numCycles'):
+        ...
+
+This module does not depend on the rest of m5 and can be run as a
+script to print a binary stats file in a text form close to stats.txt:
+
+    python binary.py m5out/stats.bin [stat name ...]
+'''
+
+import math
+import struct
+import zlib
+
+MAGIC = b'gem5stat'
+VERSION = 1
+
+# Stat kinds, see Binary::StatKind
+SCALAR, VECTOR, DIST, VECTOR_DIST, VECTOR_2D, FORMULA, SPARSE_HIST = range(7)
+
+# Distribution types, see Stats::DistType
+DEVIATION, DISTRIBUTION, HISTOGRAM = range(3)
+
+# Display flags, see base/stats/info.hh
+FLAG_TOTAL = 0x0010
+
+# Values stored ahead of the buckets of every distribution
+DIST_FIELDS = ('samples', 'sum', 'squares', 'logs', 'min_val', 'max_val',
+               'underflow', 'overflow', 'min', 'max', 'bucket_size')
+
+class _Buffer(object):
+    def __init__(self, data, order):
+        self.data = data
+        self.order = order
+        self.pos = 0
+
+    def unpack(self, fmt):
+        fmt = self.order + fmt
+        value = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return value
+
+    def int(self, fmt):
+        return self.unpack(fmt)[0]
+
+    def string(self):
+        size = self.int('I')
+        value = self.data[self.pos:self.pos + size].decode('utf-8')
+        self.pos += size
+        return value
+
+class Distribution(object):
+    '''Raw data of a distribution along with the values derived from it
+    by the text output.'''
+    def __init__(self, dist_type, values):
+        self.type = dist_type
+        for field, value in zip(DIST_FIELDS, values):
+            setattr(self, field, value)
+        self.buckets = list(values[len(DIST_FIELDS):])
+
+    @property
+    def mean(self):
+        return self.sum / self.samples if self.samples else float('nan')
+
+    @property
+    def gmean(self):
+        if not self.samples:
+            return float('nan')
+        return math.exp(self.logs / self.samples)
+
+    @property
+    def stdev(self):
+        if self.samples <= 1:
+            return float('nan')
+        n = self.samples
+        var = (n * self.squares - self.sum * self.sum) / (n * (n - 1.0))
+        return math.sqrt(var) if var >= 0 else float('nan')
+
+    @property
+    def total(self):
+        total = sum(self.buckets)
+        if self.type == DISTRIBUTION:
+            total += self.underflow + self.overflow
+        return total
+
+    def bucket_names(self):
+        names = []
+        for i in range(len(self.buckets)):
+            low = i * self.bucket_size + self.min
+            high = min(low + self.bucket_size - 1.0, self.max)
+            if low < high:
+                names.append('%g-%g' % (low, high))
+            else:
+                names.append('%g' % low)
+        return names
+
+class Stat(object):
+    '''Schema entry of a single stat.'''
+    def __init__(self, buf, separator):
+        self.kind = buf.int('B')
+        self.id = buf.int('i')
+        self.flags = buf.int('H')
+        self.precision = buf.int('i')
+        self.name = buf.string()
+        self.desc = buf.string()
+        self.separator = separator
+
+        # Position of the first value of the stat in the fixed part of
+        # a data row and number of values it holds there.
+        self.offset = 0
+        self.size = 0
+
+        self.subnames = []
+        self.subdescs = []
+        self.dists = []
+
+        if self.kind == SCALAR:
+            self.size = 1
+        elif self.kind in (VECTOR, FORMULA):
+            self.size = buf.int('I')
+            self._subnames(buf, self.size)
+        elif self.kind == DIST:
+            self.dists.append((buf.int('B'), buf.int('I')))
+        elif self.kind == VECTOR_DIST:
+            for i in range(buf.int('I')):
+                self._subnames(buf, 1)
+                self.dists.append((buf.int('B'), buf.int('I')))
+        elif self.kind == VECTOR_2D:
+            self.x = buf.int('I')
+            self.y = buf.int('I')
+            self.size = self.x * self.y
+            self._subnames(buf, self.x)
+            self.y_subnames = [ buf.string() for i in range(self.y) ]
+        elif self.kind == SPARSE_HIST:
+            self.size = 2
+        else:
+            raise ValueError("unknown stat kind %d for %s" %
+                             (self.kind, self.name))
+
+        for dist_type, buckets in self.dists:
+            self.size += len(DIST_FIELDS) + buckets
+
+    def _subnames(self, buf, count):
+        for i in range(count):
+            self.subnames.append(buf.string())
+            self.subdescs.append(buf.string())
+
+    def subname(self, i):
+        return self.subnames[i] or str(i)
+
+    def decode(self, values, tail):
+        '''Turn the values of the stat into a float (scalars), a list
+        of floats (vectors and formulas), a list of lists (2d vectors),
+        a Distribution or list of them, or a (samples, buckets) pair
+        for sparse histograms, buckets being a list of (value, count)
+        pairs. The tail argument is an iterator over the variable
+        length part of the row.'''
+        if self.kind == SCALAR:
+            return values[0]
+        if self.kind in (VECTOR, FORMULA):
+            return list(values)
+        if self.kind == VECTOR_2D:
+            return [ list(values[i * self.y:(i + 1) * self.y])
+                     for i in range(self.x) ]
+        if self.kind == SPARSE_HIST:
+            samples, count = values
+            buckets = [ (next(tail), next(tail))
+                        for i in range(int(count)) ]
+            return samples, buckets
+
+        dists = []
+        pos = 0
+        for dist_type, buckets in self.dists:
+            end = pos + len(DIST_FIELDS) + buckets
+            dists.append(Distribution(dist_type, values[pos:end]))
+            pos = end
+        return dists[0] if self.kind == DIST else dists
+
+    def flatten(self, value):
+        '''Return the (name, value) pairs the text output would print
+        for a decoded value of this stat.'''
+        base = self.name + self.separator
+        if self.kind == SCALAR:
+            return [ (self.name, value) ]
+
+        if self.kind in (VECTOR, FORMULA):
+            if len(value) == 1:
+                return [ (self.name, value[0]) ]
+            items = [ (base + self.subname(i), v)
+                      for i, v in enumerate(value) ]
+            if self.flags & FLAG_TOTAL:
+                items.append((base + 'total', sum(value)))
+            return items
+
+        if self.kind == VECTOR_2D:
+            items = []
+            for i, row in enumerate(value):
+                name = self.name + '_' + self.subname(i) + self.separator
+                for j, v in enumerate(row):
+                    sub = self.y_subnames[j] if self.y_subnames else ''
+                    items.append((name + (sub or str(j)), v))
+            return items
+
+        if self.kind == SPARSE_HIST:
+            samples, buckets = value
+            items = [ (base + 'samples', samples) ]
+            items += [ (base + '%g' % k, c) for k, c in buckets ]
+            return items
+
+        if self.kind == DIST:
+            return self._flatten_dist(base, value)
+
+        items = []
+        for i, dist in enumerate(value):
+            name = self.name + '_' + self.subname(i) + self.separator
+            items += self._flatten_dist(name, dist)
+        return items
+
+    def _flatten_dist(self, base, dist):
+        items = [ (base + 'samples', dist.samples),
+                  (base + 'mean', dist.mean) ]
+        if dist.type == HISTOGRAM:
+            items.append((base + 'gmean', dist.gmean))
+        items.append((base + 'stdev', dist.stdev))
+        if dist.type == DEVIATION:
+            return items
+
+        if dist.type == DISTRIBUTION:
+            items.append((base + 'underflows', dist.underflow))
+        items += [ (base + name, v)
+                   for name, v in zip(dist.bucket_names(), dist.buckets) ]
+        if dist.type == DISTRIBUTION:
+            items += [ (base + 'overflows', dist.overflow),
+                       (base + 'min_value', dist.min_val),
+                       (base + 'max_value', dist.max_val) ]
+        items.append((base + 'total', dist.total))
+        return items
+
+class Dump(object):
+    '''All stats of a single dump, indexed by stat name.'''
+    def __init__(self, tick, stats, values):
+        self.tick = tick
+        self.stats = stats
+        self.values = values
+
+    def __getitem__(self, name):
+        return self.values[name]
+
+    def __contains__(self, name):
+        return name in self.values
+
+    def items(self):
+        return [ (stat.name, self.values[stat.name]) for stat in self.stats ]
+
+    def flatten(self):
+        items = []
+        for stat in self.stats:
+            items += stat.flatten(self.values[stat.name])
+        return items
+
+class BinaryStats(object):
+    def __init__(self, filename):
+        self.filename = filename
+
+        with open(filename, 'rb') as f:
+            header = f.read(16)
+        if len(header) < 16 or header[:8] != MAGIC:
+            raise ValueError("%s is not a binary stats file" % filename)
+
+        for order in '<>':
+            version, mark = struct.unpack_from(order + 'II', header, 8)
+            if mark == 0x01020304:
+                break
+        else:
+            raise ValueError("%s has an invalid byte order mark" % filename)
+
+        if version != VERSION:
+            raise ValueError("%s has unsupported version %d" %
+                             (filename, version))
+        self.order = order
+
+    def records(self):
+        '''Iterate over the (kind, payload) pairs of the file.'''
+        rec_header = self.order + 'BBHII'
+        rec_size = struct.calcsize(rec_header)
+        with open(self.filename, 'rb') as f:
+            f.seek(16)
+            while True:
+                header = f.read(rec_size)
+                if len(header) < rec_size:
+                    return
+                kind, flags, reserved, raw, stored = \
+                      struct.unpack(rec_header, header)
+                payload = f.read(stored)
+                if len(payload) < stored:
+                    # truncated file, e.g., the simulation is still
+                    # running or was killed in the middle of a dump
+                    return
+                if flags & 0x1:
+                    payload = zlib.decompress(payload)
+                assert len(payload) == raw
+                yield chr(kind), payload
+
+    def _schema(self, payload):
+        buf = _Buffer(payload, self.order)
+        count = buf.int('I')
+        separator = buf.string()
+        stats = []
+        offset = 0
+        for i in range(count):
+            stat = Stat(buf, separator)
+            stat.offset = offset
+            offset += stat.size
+            stats.append(stat)
+        return stats, offset
+
+    def _rows(self):
+        stats, size = [], 0
+        for kind, payload in self.records():
+            if kind == 'S':
+                stats, size = self._schema(payload)
+            elif kind == 'D':
+                yield stats, size, payload
+
+    def dumps(self):
+        '''Decode every dump of the file.'''
+        for stats, size, payload in self._rows():
+            tick, = struct.unpack_from(self.order + 'Q', payload, 0)
+            fixed = struct.unpack_from('%s%dd' % (self.order, size),
+                                       payload, 8)
+            pos = 8 + 8 * size
+            tail = iter(struct.unpack_from(
+                '%s%dd' % (self.order, (len(payload) - pos) // 8),
+                payload, pos))
+
+            values = {}
+            for stat in stats:
+                values[stat.name] = stat.decode(
+                    fixed[stat.offset:stat.offset + stat.size], tail)
+            yield Dump(tick, stats, values)
+
+    def column(self, name):
+        '''Return the (tick, value) pairs of a single stat across all
+        dumps, only unpacking the values of that stat.'''
+        result = []
+        schema = None
+        for stats, size, payload in self._rows():
+            if stats is not schema:
+                schema = stats
+                matches = [ s for s in stats if s.name == name ]
+                stat = matches[0] if matches else None
+                # sparse histograms ahead of the stat in the schema,
+                # whose buckets come first in the tail of the row
+                sparse = [ s for s in stats[:stats.index(stat)]
+                           if s.kind == SPARSE_HIST ] if stat else []
+
+            if stat is None:
+                continue
+
+            tick, = struct.unpack_from(self.order + 'Q', payload, 0)
+            values = struct.unpack_from(
+                '%s%dd' % (self.order, stat.size),
+                payload, 8 + 8 * stat.offset)
+
+            tail = None
+            if stat.kind == SPARSE_HIST:
+                pos = 8 + 8 * size
+                for s in sparse:
+                    count, = struct.unpack_from(
+                        self.order + 'd', payload, 8 + 8 * (s.offset + 1))
+                    pos += 16 * int(count)
+                tail = iter(struct.unpack_from(
+                    '%s%dd' % (self.order, 2 * int(values[1])),
+                    payload, pos))
+
+            result.append((tick, stat.decode(values, tail)))
+        return result
+
+def main(args):
+    import sys
+
+    if not args:
+        sys.exit("usage: binary.py <stats file> [stat name ...]")
+
+    stats = BinaryStats(args[0])
+    names = set(args[1:])
+    out = sys.stdout
+    for dump in stats.dumps():
+        out.write("\n---------- Begin Simulation Statistics ----------\n")
+        out.write("%-40s %12d\n" % ('tick', dump.tick))
+        for stat in dump.stats:
+            if names and stat.name not in names:
+                continue
+            for name, value in stat.flatten(dump[stat.name]):
+                out.write("%-40s %12s\n" % (name, '%.6g' % value))
+        out.write("\n---------- End Simulation Statistics   ----------\n")
+
+if __name__ == '__main__':
+    import sys
+    main(sys.argv[1:])
@@ -54,6 +54,7 @@ const bool flag_NDEBUG = false;
 const bool flag_TRACING_ON = TRACING_ON;
 
 inline void disableAllListeners() { ListenSocket::disableAll(); }
+inline bool listenersDisabled() { return ListenSocket::allDisabled(); }
 
 inline void
 seedRandom(uint64_t seed)
@@ -69,8 +70,11 @@ seedRandom(uint64_t seed)
 %include "base/types.hh"
 
 void setOutputDir(const std::string &dir);
+void prepareFork();
+void relocateOutputDir(const std::string &dir);
 void doExitCleanup();
 void disableAllListeners();
+bool listenersDisabled();
 void seedRandom(uint64_t seed);
 
 %immutable compileDate;
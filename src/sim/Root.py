@@ -33,6 +33,11 @@ from m5.defines import buildEnv
 from m5.params import *
 from m5.util import fatal
 
+# Data structure used by the main event queues to order pending
+# events. Both service events in exactly the same order; 'calendar'
+# scales better with the number of distinct pending event times.
+class EventQueueImpl(Enum): vals = ['sorted_list', 'calendar']
+
 class Root(SimObject):
 
     _the_instance = None
@@ -66,9 +71,14 @@ class Root(SimObject):
     eventq_index = 0
 
     # Simulation Quantum for multiple main event queue simulation.
-    # Needs to be set explicitly for a multi-eventq simulation.
+    # Needs to be set explicitly for a multi-eventq simulation, unless
+    # the links between the event queues declare their lookahead, in
+    # which case it defaults to the smallest lookahead.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    eventq_impl = Param.EventQueueImpl('sorted_list',
+        "data structure used to order events on the main event queues")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
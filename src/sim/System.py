@@ -66,6 +66,24 @@ class System(MemObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    # The backing store is checkpointed in chunks that are compressed
+    # in parallel. Uncompressed chunks are mapped lazily from the
+    # checkpoint on restore rather than read. Incremental checkpoints
+    # only hold the pages changed since the last checkpoint taken or
+    # restored, and need the files of that checkpoint to be restored.
+    # Full checkpoints can also be stored as plain (sparse) images of
+    # the backing store, which are restored with a single copy-on-write
+    # mapping, e.g., to restore the same checkpoint many times.
+    pmem_cpt_chunk_size = Param.MemorySize('64MB', "Size of the chunks " \
+                                               "of memory checkpoints")
+    pmem_cpt_threads = Param.Unsigned(0, "Threads compressing memory " \
+                                          "checkpoints, 0 for all host cores")
+    pmem_cpt_compress = Param.Bool(True, "Compress memory checkpoints")
+    pmem_cpt_incremental = Param.Bool(False, "Only checkpoint the memory " \
+                                          "changed since the last checkpoint")
+    pmem_cpt_image = Param.Bool(False, "Store full memory checkpoints as " \
+                                    "images mapped copy-on-write on restore")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -173,6 +173,32 @@ class Clocked
         return tick + clockPeriod() * cycles;
     }
 
+    /**
+     * Determine the tick when a cycle begins as seen from a tick that
+     * may lie in the future, rather than from curTick(), assuming
+     * that the clock period does not change until then. This is
+     * useful for objects that accept work ahead of time.
+     *
+     * @param when The tick to align, which is no earlier than curTick()
+     * @param cycles The number of cycles after the aligned tick
+     *
+     * @return The start tick when the requested clock edge occurs,
+     * i.e. when + [0, clockPeriod()) + clockPeriod() * cycles
+     */
+    inline Tick clockEdgeAt(Tick when, Cycles cycles = Cycles(0)) const
+    {
+        assert(when >= curTick());
+
+        // align tick to the next clock edge as seen from now, and
+        // then move on to the first one at or after the given tick
+        update();
+        Tick edge = tick;
+        if (when > edge)
+            edge += divCeil(when - edge, clockPeriod()) * clockPeriod();
+
+        return edge + clockPeriod() * cycles;
+    }
+
     /**
      * Determine the current cycle, corresponding to a tick aligned to
      * a clock edge.
@@ -35,6 +35,7 @@
 #include <string>
 
 #include "base/callback.hh"
+#include "base/misc.hh"
 #include "base/output.hh"
 #include "sim/core.hh"
 #include "sim/eventq.hh"
@@ -98,6 +99,25 @@ setOutputDir(const string &dir)
     simout.setDirectory(dir);
 }
 
+void
+prepareFork()
+{
+    // only the forking thread survives in the child
+    fatal_if(numMainEventQueues > 1,
+             "Can't fork a simulator running %d event queues\n",
+             numMainEventQueues);
+
+    simout.flush();
+    cout.flush();
+    cerr.flush();
+}
+
+void
+relocateOutputDir(const string &dir)
+{
+    simout.relocate(dir);
+}
+
 /**
  * Queue of C++ callbacks to invoke on simulator exit.
  */
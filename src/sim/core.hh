@@ -95,6 +95,17 @@ void setClockFrequency(Tick ticksPerSecond);
 
 void setOutputDir(const std::string &dir);
 
+/**
+ * Get ready for the simulator to fork() by flushing all output, see
+ * m5.simulate.fork().
+ */
+void prepareFork();
+
+/**
+ * Move the output of a forked simulator to its own directory.
+ */
+void relocateOutputDir(const std::string &dir);
+
 class Callback;
 void registerExitCallback(Callback *callback);
 void doExitCleanup();
@@ -32,6 +32,7 @@
  *          Steve Raasch
  */
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -43,6 +44,7 @@
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 #include "sim/core.hh"
+#include "sim/eventq_calendar.hh"
 #include "sim/eventq_impl.hh"
 
 using namespace std;
@@ -59,6 +61,10 @@ uint32_t numMainEventQueues = 0;
 vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+EventQueue::Impl mainEventQueueImpl = EventQueue::SortedList;
+
+//! Smallest lookahead declared between two main event queues.
+static Tick _minLookahead = MaxTick;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -66,12 +72,41 @@ getEventQueue(uint32_t index)
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueImpl, numMainEventQueues - 1));
     }
 
     return mainEventQueue[index];
 }
 
+void
+declareLookahead(uint32_t src, uint32_t dst, Tick lookahead)
+{
+    if (src == dst)
+        return;
+
+    if (lookahead == 0)
+        fatal("Link from event queue %d to %d has no lookahead\n", src, dst);
+
+    DPRINTF(Event, "Lookahead from event queue %d to %d: %d\n",
+            src, dst, lookahead);
+    _minLookahead = std::min(_minLookahead, lookahead);
+}
+
+Tick
+minLookahead()
+{
+    return _minLookahead;
+}
+
+void
+setMainEventQueueImpl(EventQueue::Impl impl)
+{
+    mainEventQueueImpl = impl;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->setImpl(impl);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -117,6 +152,12 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    if (calendar) {
+        calendar->insert(event);
+        head = calendar->getHead();
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -176,6 +217,12 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->getHead();
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -208,7 +255,11 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (calendar) {
+        // the head is the first bin of its bucket, so this is cheap
+        calendar->remove(event);
+        head = calendar->getHead();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -220,6 +271,9 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    lastServicedWhen = event->when();
+    lastServicedPriority = event->priority();
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
@@ -300,7 +354,12 @@ EventQueue::dump() const
 
     if (empty())
         cprintf("<No Events>\n");
-    else {
+    else if (calendar) {
+        for (auto bin : calendar->sortedBins()) {
+            for (Event *e = bin; e; e = e->nextInBin)
+                e->dump();
+        }
+    } else {
         Event *nextBin = head;
         while (nextBin) {
             Event *nextInBin = nextBin;
@@ -324,8 +383,20 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    // Verify the calendar itself, then walk its bins in order as if
+    // they were on the sorted list.
+    if (calendar && !calendar->debugVerify())
+        return false;
+
+    vector<Event *> bins;
+    if (calendar) {
+        bins = calendar->sortedBins();
+    } else {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    for (auto nextBin : bins) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -351,8 +422,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -361,11 +430,38 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (calendar) {
+        // Hand out and take in the bins in the same shape as the
+        // sorted list so that callers don't need to care.
+        Event* t = calendar->extract();
+        calendar->insertList(s);
+        head = calendar->getHead();
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
 }
 
+void
+EventQueue::setImpl(Impl impl)
+{
+    if (impl == getImpl())
+        return;
+
+    Event *bins = replaceHead(NULL);
+
+    if (impl == Calendar) {
+        calendar = new EventCalendar();
+    } else {
+        delete calendar;
+        calendar = NULL;
+    }
+
+    replaceHead(bins);
+}
+
 void
 dumpMainQueue()
 {
@@ -414,16 +510,31 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const string &n, Impl impl, uint32_t index)
+    : objName(n), head(NULL), _curTick(0), calendar(NULL), _index(index),
+      lastServicedWhen(0), lastServicedPriority(Event::Minimum_Pri),
+      asyncSeqNum(0)
 {
+    setImpl(impl);
+}
+
+EventQueue::~EventQueue()
+{
+    delete calendar;
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
+    // The sequence number belongs to the inserting thread's queue, so
+    // it is only ever touched by that thread.
+    EventQueue *src = curEventQueue();
+    AsyncInsertion insertion = {
+        event, src ? src->index() : 0, src ? src->asyncSeqNum++ : 0
+    };
+
     async_queue_mutex.lock();
-    async_queue.push_back(event);
+    async_queue.push_back(insertion);
     async_queue_mutex.unlock();
 }
 
@@ -433,10 +544,37 @@ EventQueue::handleAsyncInsertions()
     assert(this == curEventQueue());
     async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    // The order in which other threads got to the async queue depends
+    // on host timing. Sort the insertions so that events in the same
+    // bin always end up in the same order.
+    std::sort(async_queue.begin(), async_queue.end(),
+              [](const AsyncInsertion &l, const AsyncInsertion &r) {
+                  if (*l.event != *r.event)
+                      return *l.event < *r.event;
+                  if (l.srcQueue != r.srcQueue)
+                      return l.srcQueue < r.srcQueue;
+                  return l.seqNum < r.seqNum;
+              });
+
+    // Inserting an event puts it on top of its bin, so insert the
+    // events in reverse to have the ones sharing a bin serviced in
+    // the order they were scheduled in, like messages in a FIFO.
+    for (auto i = async_queue.rbegin(); i != async_queue.rend(); ++i) {
+        Event *event = i->event;
+        if (_minLookahead != MaxTick &&
+            (event->when() < lastServicedWhen ||
+             (event->when() == lastServicedWhen &&
+              event->priority() <= lastServicedPriority))) {
+            panic("%s: event %s from queue %d scheduled for %d with "
+                  "priority %d, not after the last serviced event at %d "
+                  "with priority %d, the lookahead of a link has been "
+                  "violated\n", name(), event->name(), i->srcQueue,
+                  event->when(), (int)event->priority(), lastServicedWhen,
+                  (int)lastServicedPriority);
+        }
+        insert(event);
     }
+    async_queue.clear();
 
     async_queue_mutex.unlock();
 }
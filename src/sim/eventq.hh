@@ -53,6 +53,7 @@
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
+class EventCalendar;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -65,6 +66,18 @@ extern Tick simQuantum;
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
+//! Declare the lookahead of a link between two main event queues, i.e.,
+//! that anything sent from queue src to queue dst over the link is
+//! scheduled at least lookahead ticks into the future. Once a
+//! lookahead has been declared, the simulation is synchronized
+//! conservatively: the quantum defaults to the smallest lookahead
+//! and events crossing queues are not allowed to arrive in the past.
+void declareLookahead(uint32_t src, uint32_t dst, Tick lookahead);
+
+//! Smallest lookahead declared between any two main event queues, or
+//! MaxTick if no lookahead has been declared.
+Tick minLookahead();
+
 //! Array for main event queues.
 extern std::vector<EventQueue *> mainEventQueue;
 
@@ -188,6 +201,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -441,19 +455,59 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * Pending events are grouped in bins of events with the same time
+ * and priority. By default, the bins are kept in a single sorted
+ * list, which makes scheduling linear in the number of distinct
+ * pending (when, priority) pairs. Queues with many pending bins can
+ * instead index them with a calendar queue (see EventCalendar and
+ * setImpl()), which services events in exactly the same order.
  */
 class EventQueue
 {
+  public:
+    /** Data structure used to keep the pending bins in order. */
+    enum Impl {
+        SortedList,     //!< Single time-sorted list of bins
+        Calendar,       //!< Calendar queue of bins, see EventCalendar
+    };
+
   private:
     std::string objName;
     Event *head;
     Tick _curTick;
 
+    //! Calendar indexing the bins when using the Calendar
+    //! implementation, NULL when using the sorted list.
+    EventCalendar *calendar;
+
+    //! Index of this queue among the main event queues.
+    uint32_t _index;
+
+    //! Time and priority of the last event taken off the queue, which
+    //! events from other queues must come after.
+    Tick lastServicedWhen;
+    Event::Priority lastServicedPriority;
+
+    //! Number of asynchronous insertions done by this queue's thread
+    //! so far, used to order them deterministically.
+    uint64_t asyncSeqNum;
+
+    //! An event inserted by another thread, along with the queue and
+    //! sequence number of the insertion to break ties between
+    //! insertions deterministically, regardless of thread timing.
+    struct AsyncInsertion
+    {
+        Event *event;
+        uint32_t srcQueue;
+        uint64_t seqNum;
+    };
+
     //! Mutex to protect async queue.
     std::mutex async_queue_mutex;
 
     //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    std::vector<AsyncInsertion> async_queue;
 
     /**
      * Lock protecting event handling.
@@ -552,11 +606,15 @@ class EventQueue
     };
 #endif
 
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n, Impl impl = SortedList,
+               uint32_t index = 0);
 
     virtual const std::string name() const { return objName; }
     void name(const std::string &st) { objName = st; }
 
+    //! Index of this queue among the main event queues.
+    uint32_t index() const { return _index; }
+
     //! Schedule the given event on this queue. Safe to call from any
     //! thread.
     void schedule(Event *event, Tick when, bool global = false);
@@ -574,6 +632,15 @@ class EventQueue
     Tick getCurTick() const { return _curTick; }
     Event *getHead() const { return head; }
 
+    //! Would an event scheduled at the given time and priority have
+    //! been serviced by now?
+    bool
+    isServiced(Tick when, Event::Priority priority) const
+    {
+        return lastServicedWhen > when ||
+            (lastServicedWhen == when && lastServicedPriority > priority);
+    }
+
     Event *serviceOne();
 
     // process all events up to the given timestamp.  we inline a
@@ -604,7 +671,9 @@ class EventQueue
 
     bool debugVerify() const;
 
-    //! Function for moving events from the async_queue to the main queue.
+    //! Function for moving events from the async_queue to the main
+    //! queue. Events are merged in (when, priority, source queue,
+    //! insertion order) order to keep the simulation deterministic.
     void handleAsyncInsertions();
 
     /**
@@ -632,6 +701,14 @@ class EventQueue
      */
     Event* replaceHead(Event* s);
 
+    //! Data structure currently used to order pending events.
+    Impl getImpl() const { return calendar ? Calendar : SortedList; }
+
+    //! Switch to a different data structure for ordering pending
+    //! events, migrating any pending events to it. Should be called
+    //! only from the owning thread.
+    void setImpl(Impl impl);
+
     /**@{*/
     /**
      * Provide an interface for locking/unlocking the event queue.
@@ -661,9 +738,19 @@ class EventQueue
      */
     void checkpointReschedule(Event *event);
 
-    virtual ~EventQueue() { }
+    virtual ~EventQueue();
 };
 
+#ifndef SWIG
+//! Implementation used for main event queues, including the ones
+//! allocated later on by getEventQueue().
+extern EventQueue::Impl mainEventQueueImpl;
+#endif
+
+//! Switch all current and future main event queues to a different
+//! implementation.
+void setMainEventQueueImpl(EventQueue::Impl impl);
+
 void dumpMainQueue();
 
 #ifndef SWIG
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_calendar.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "base/misc.hh"
+#include "sim/eventq.hh"
+
+using namespace std;
+
+EventCalendar::EventCalendar()
+    : buckets(minBuckets, NULL), bucketMask(minBuckets - 1),
+      widthShift(defaultWidthShift), numBins(0), head(NULL)
+{
+}
+
+void
+EventCalendar::insertBin(Event *bin)
+{
+    Event **link = &bucket(bin->when());
+    while (*link && **link < *bin)
+        link = &(*link)->nextBin;
+
+    assert(!*link || *bin < **link);
+    bin->nextBin = *link;
+    *link = bin;
+}
+
+void
+EventCalendar::insert(Event *event)
+{
+    // Find the bin the event belongs to, or the bin it needs to be
+    // inserted in front of, keeping track of the pointer that links
+    // to it so that we can update it in place.
+    Event **link = &bucket(event->when());
+    Event *curr = *link;
+    while (curr && *curr < *event) {
+        link = &curr->nextBin;
+        curr = curr->nextBin;
+    }
+
+    bool new_bin = !curr || *event < *curr;
+    Event *top = Event::insertBefore(event, curr);
+    *link = top;
+
+    // The event is either the new top of the head bin or starts a
+    // new, earlier bin.
+    if (!head || *top <= *head)
+        head = top;
+
+    if (new_bin && ++numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+EventCalendar::remove(Event *event)
+{
+    Event **link = &bucket(event->when());
+    Event *curr = *link;
+    while (curr && *curr < *event) {
+        link = &curr->nextBin;
+        curr = curr->nextBin;
+    }
+
+    if (!curr || *curr != *event)
+        panic("event not found!");
+
+    bool bin_gone = event == curr && !curr->nextInBin;
+    *link = Event::removeItem(event, curr);
+
+    if (!bin_gone) {
+        // The bin is still there, but it may have a new top
+        if (curr == head)
+            head = *link;
+        return;
+    }
+
+    --numBins;
+    if (curr == head)
+        head = findHead(event->when());
+
+    if (numBins < buckets.size() / 2 && buckets.size() > minBuckets)
+        resize(buckets.size() / 2);
+}
+
+Event *
+EventCalendar::findHead(Tick from)
+{
+    if (numBins == 0)
+        return NULL;
+
+    // All remaining bins are at or after the bin that just left, so
+    // walk the buckets day by day starting at its day. The first bin
+    // of a bucket belongs to the current day (rather than to a later
+    // year) if its day number isn't beyond the one we are looking at.
+    Tick day = from >> widthShift;
+    for (size_t i = 0; i < buckets.size(); ++i, ++day) {
+        Event *first = buckets[day & bucketMask];
+        if (first && (first->when() >> widthShift) <= day)
+            return first;
+    }
+
+    // Nothing within a year, the pending bins are sparse compared to
+    // the bucket width. Fall back to a direct search.
+    Event *min = NULL;
+    for (auto first : buckets) {
+        if (first && (!min || *first < *min))
+            min = first;
+    }
+
+    return min;
+}
+
+void
+EventCalendar::collectBins(vector<Event *> &bins) const
+{
+    for (auto first : buckets) {
+        for (Event *bin = first; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+}
+
+void
+EventCalendar::resize(size_t num_buckets)
+{
+    vector<Event *> bins;
+    bins.reserve(numBins);
+    collectBins(bins);
+    rebuild(bins, num_buckets);
+}
+
+void
+EventCalendar::rebuild(vector<Event *> &bins, size_t num_buckets)
+{
+    assert(isPowerOf2(num_buckets));
+
+    // Estimate the average distance between the earliest pending
+    // ticks. Following Brown, separations that are more than twice
+    // the average are ignored and the bucket width is set to three
+    // times the resulting average. Bins sharing a tick (i.e., with
+    // different priorities) don't contribute to the estimate.
+    const size_t samples = min<size_t>(bins.size(), 25);
+    partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                 [](const Event *l, const Event *r) { return *l < *r; });
+
+    vector<Tick> seps;
+    for (size_t i = 1; i < samples; ++i) {
+        if (bins[i]->when() != bins[i - 1]->when())
+            seps.push_back(bins[i]->when() - bins[i - 1]->when());
+    }
+
+    if (!seps.empty()) {
+        Tick avg = 0;
+        for (auto sep : seps)
+            avg += sep / seps.size();
+
+        Tick total = 0;
+        size_t count = 0;
+        for (auto sep : seps) {
+            if (sep <= 2 * avg) {
+                total += sep;
+                ++count;
+            }
+        }
+
+        Tick width = count ? total / count : avg;
+        width = width < MaxTick / 3 ? 3 * width : width;
+        widthShift = width > 1 ? min(ceilLog2(width), 63) : 0;
+    }
+
+    buckets.assign(num_buckets, NULL);
+    bucketMask = num_buckets - 1;
+    for (auto bin : bins)
+        insertBin(bin);
+}
+
+Event *
+EventCalendar::extract()
+{
+    vector<Event *> bins(sortedBins());
+
+    Event *list = NULL;
+    for (auto bin = bins.rbegin(); bin != bins.rend(); ++bin) {
+        (*bin)->nextBin = list;
+        list = *bin;
+    }
+
+    buckets.assign(minBuckets, NULL);
+    bucketMask = minBuckets - 1;
+    numBins = 0;
+    head = NULL;
+
+    return list;
+}
+
+void
+EventCalendar::insertList(Event *list)
+{
+    if (!list)
+        return;
+
+    vector<Event *> bins;
+    bins.reserve(numBins);
+    collectBins(bins);
+
+    for (Event *bin = list; bin; bin = bin->nextBin) {
+        bins.push_back(bin);
+        if (!head || *bin < *head)
+            head = bin;
+    }
+
+    numBins = bins.size();
+
+    size_t num_buckets = minBuckets;
+    while (numBins > 2 * num_buckets)
+        num_buckets *= 2;
+
+    rebuild(bins, num_buckets);
+}
+
+vector<Event *>
+EventCalendar::sortedBins() const
+{
+    vector<Event *> bins;
+    bins.reserve(numBins);
+    collectBins(bins);
+    sort(bins.begin(), bins.end(),
+         [](const Event *l, const Event *r) { return *l < *r; });
+
+    return bins;
+}
+
+bool
+EventCalendar::debugVerify() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        for (Event *bin = buckets[i]; bin; bin = bin->nextBin) {
+            if (((bin->when() >> widthShift) & bucketMask) != i) {
+                cprintf("bin in wrong bucket!");
+                bin->dump();
+                return false;
+            }
+
+            if (bin->nextBin && !(*bin < *bin->nextBin)) {
+                cprintf("bucket out of order!");
+                bin->dump();
+                return false;
+            }
+
+            if (!head || *bin < *head) {
+                cprintf("head is not the earliest bin!");
+                bin->dump();
+                return false;
+            }
+
+            ++count;
+        }
+    }
+
+    if (count != numBins) {
+        cprintf("bin count mismatch!");
+        return false;
+    }
+
+    return true;
+}
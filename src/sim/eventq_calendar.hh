@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Calendar queue index for the bins of an EventQueue
+ */
+
+#ifndef __SIM_EVENTQ_CALENDAR_HH__
+#define __SIM_EVENTQ_CALENDAR_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+
+class Event;
+
+/**
+ * Calendar queue (R. Brown, CACM 1988) over the event bins of an
+ * EventQueue.
+ *
+ * A bin is the LIFO stack of events sharing the same (when, priority)
+ * pair, exactly as in the sorted list used by default; only the way
+ * bins are found differs. Bins are hashed into a power-of-two number
+ * of buckets ("days") of a power-of-two width in ticks, and each
+ * bucket keeps its bins sorted through the nextBin pointer. As long as
+ * the bucket width tracks the typical distance between pending bins,
+ * every bucket holds a handful of bins and insertion, removal and
+ * finding the next bin are all constant time on average. The number
+ * of buckets and their width are re-evaluated whenever the number of
+ * bins doubles or halves.
+ *
+ * Since bins and the order within a bin are untouched, events are
+ * serviced in exactly the same order as with the sorted list.
+ */
+class EventCalendar
+{
+  private:
+    /** First (earliest) bin of each bucket, NULL if the bucket is empty. */
+    std::vector<Event *> buckets;
+
+    /** Number of buckets minus one, used to wrap bucket indices. */
+    Tick bucketMask;
+
+    /** log2 of the bucket width in ticks. */
+    int widthShift;
+
+    /** Number of bins currently in the calendar. */
+    size_t numBins;
+
+    /** Earliest bin in the calendar, NULL if empty. */
+    Event *head;
+
+    static const size_t minBuckets = 16;
+    static const int defaultWidthShift = 10;
+
+    Event *&
+    bucket(Tick when)
+    {
+        return buckets[(when >> widthShift) & bucketMask];
+    }
+
+    /**
+     * Link a complete bin into its bucket. The calendar must not
+     * already contain a bin with the same (when, priority).
+     */
+    void insertBin(Event *bin);
+
+    /**
+     * Find the earliest bin once the previous head bin, scheduled at
+     * tick from, has left the calendar.
+     */
+    Event *findHead(Tick from);
+
+    /** Collect the top event of every bin in no particular order. */
+    void collectBins(std::vector<Event *> &bins) const;
+
+    /** Relink the pending bins into a new number of buckets. */
+    void resize(size_t num_buckets);
+
+    /**
+     * Link a set of bins into a fresh calendar of the given size,
+     * picking a bucket width from the spacing of the earliest bins.
+     */
+    void rebuild(std::vector<Event *> &bins, size_t num_buckets);
+
+  public:
+    EventCalendar();
+
+    /** Earliest bin, NULL if the calendar is empty. */
+    Event *getHead() const { return head; }
+
+    /** Insert an event, either in a new bin or on top of its bin. */
+    void insert(Event *event);
+
+    /** Remove an event, panicking if it cannot be found. */
+    void remove(Event *event);
+
+    /**
+     * Empty the calendar and return its bins as a time-sorted list
+     * linked through nextBin, i.e., in the same shape as the head of
+     * the default sorted list.
+     */
+    Event *extract();
+
+    /** Insert all bins of a time-sorted list as returned by extract(). */
+    void insertList(Event *list);
+
+    /** Return the top event of every bin sorted in servicing order. */
+    std::vector<Event *> sortedBins() const;
+
+    /** Check that every bin lives in the right bucket, in order. */
+    bool debugVerify() const;
+};
+
+#endif // __SIM_EVENTQ_CALENDAR_HH__
@@ -280,6 +280,12 @@ class ProbePointArg : public ProbePoint
                         listeners.end());
     }
 
+    /**
+     * @brief checks if any ProbeListener is attached to this ProbePoint.
+     * @return true if notify() has any effect.
+     */
+    bool hasListeners() const { return !listeners.empty(); }
+
     /**
      * @brief called at the ProbePoint call site, passes arg to each listener.
      * @param arg the argument to pass to each listener.
@@ -114,6 +114,9 @@ Root::Root(RootParams *p) : SimObject(p), _enabled(false),
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+
+    setMainEventQueueImpl(p->eventq_impl == Enums::calendar ?
+                          EventQueue::Calendar : EventQueue::SortedList);
 }
 
 void
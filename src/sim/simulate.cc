@@ -114,10 +114,27 @@ simulate(Tick num_cycles)
 
     GlobalSyncEvent *quantum_event = NULL;
     if (numMainEventQueues > 1) {
+        // If the links between the queues have declared their
+        // lookahead, no event crossing queues can land within the
+        // quantum it was sent in as long as the quantum is no larger
+        // than the smallest lookahead. This keeps the parallel
+        // simulation deterministic.
+        Tick lookahead = minLookahead();
+        if (simQuantum == 0 && lookahead != MaxTick) {
+            inform("Using minimum link lookahead of %d ticks as quantum\n",
+                   lookahead);
+            simQuantum = lookahead;
+        }
+
         if (simQuantum == 0) {
             fatal("Quantum for multi-eventq simulation not specified");
         }
 
+        if (simQuantum > lookahead) {
+            fatal("Quantum (%d) exceeds the minimum link lookahead (%d)\n",
+                  simQuantum, lookahead);
+        }
+
         quantum_event = new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
                             EventBase::Progress_Event_Pri, 0);
 
@@ -83,14 +83,19 @@ System::System(Params *p)
       multiThread(p->multi_thread),
       pagePtr(0),
       init_param(p->init_param),
-      physProxy(_systemPort, p->cache_line_size),
+      physProxy(_systemPort, p->cache_line_size, &physmem),
       kernelSymtab(nullptr),
       kernel(nullptr),
       loadAddrMask(p->load_addr_mask),
       loadAddrOffset(p->load_offset),
       nextPID(0),
-      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve),
+      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve,
+              p->pmem_cpt_chunk_size, p->pmem_cpt_threads,
+              p->pmem_cpt_compress, p->pmem_cpt_incremental,
+              p->pmem_cpt_image),
       memoryMode(p->mem_mode),
+      numCaches(0), numWriteBuffers(0), memBackdoorDisabled(false),
+      startedUp(false),
       _cacheLineSize(p->cache_line_size),
       workItemsBegin(0),
       workItemsEnd(0),
@@ -102,6 +107,8 @@ System::System(Params *p)
     // add self to global system list
     systemList.push_back(this);
 
+    updateMemBackdoor();
+
     if (FullSystem) {
         kernelSymtab = new SymbolTable;
         if (!debugSymbolTable)
@@ -194,6 +201,16 @@ System::setMemoryMode(Enums::MemoryMode mode)
 {
     assert(drainState() == DrainState::Drained);
     memoryMode = mode;
+    updateMemBackdoor();
+}
+
+void
+System::updateMemBackdoor()
+{
+    physmem.enableBackdoor(!memBackdoorDisabled &&
+                           (!startedUp || bypassCaches() ||
+                            (numCaches == 0 &&
+                             (isAtomicMode() || numWriteBuffers == 0))));
 }
 
 bool System::breakpoint()
@@ -305,6 +322,15 @@ System::initState()
     }
 }
 
+void
+System::startup()
+{
+    // From now on caches and buffers may hold data that is not in
+    // memory yet
+    startedUp = true;
+    updateMemBackdoor();
+}
+
 void
 System::replaceThreadContext(ThreadContext *tc, ContextID context_id)
 {
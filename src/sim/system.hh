@@ -278,6 +278,44 @@ class System : public MemObject
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * @{
+     * @name Memory backdoor
+     *
+     * Functional accesses can skip the memory system and directly
+     * copy to and from the backing store of the memories (see
+     * PhysicalMemory::backdoor()) as long as nothing else may hold a
+     * more recent copy of the data. This is the case before the
+     * simulation starts, when bypassing caches, and without caches
+     * in atomic mode, since atomic accesses leave nothing in flight.
+     * Memories update their store as soon as they accept a timing
+     * write, so without caches this also holds in timing mode, as
+     * long as nothing queues writes on their way to memory.
+     */
+
+    /**
+     * Tell the system that a cache may hold data not yet written
+     * back to memory. Called by caches on construction.
+     */
+    void registerCache() { ++numCaches; updateMemBackdoor(); }
+
+    /**
+     * Tell the system that timing writes to memory may be queued on
+     * their way there, e.g. in a bridge. Called on construction.
+     */
+    void registerWriteBuffer() { ++numWriteBuffers; updateMemBackdoor(); }
+
+    /**
+     * Never use the memory backdoor, for memory systems where the
+     * memories are not the functional store of the data.
+     */
+    void disableMemBackdoor()
+    {
+        memBackdoorDisabled = true;
+        updateMemBackdoor();
+    }
+    /** @} */
+
     /**
      * Get the architecture.
      */
@@ -299,6 +337,21 @@ class System : public MemObject
 
     Enums::MemoryMode memoryMode;
 
+    /** Number of caches in the system, see registerCache(). */
+    unsigned numCaches;
+
+    /** Number of write buffers, see registerWriteBuffer(). */
+    unsigned numWriteBuffers;
+
+    /** Functional accesses never use the memory backdoor. */
+    bool memBackdoorDisabled;
+
+    /** Has startup() been called, i.e. has the simulation started? */
+    bool startedUp;
+
+    /** Enable or disable the memory backdoor as appropriate. */
+    void updateMemBackdoor();
+
     const unsigned int _cacheLineSize;
 
     uint64_t workItemsBegin;
@@ -488,6 +541,7 @@ class System : public MemObject
     ~System();
 
     void initState() override;
+    void startup() override;
 
     const Params *params() const { return (const Params *)_params; }
 
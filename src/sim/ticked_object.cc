@@ -46,6 +46,9 @@ Ticked::Ticked(ClockedObject &object_,
     event(*this, priority),
     running(false),
     lastStopped(0),
+    nextTickDelay(1),
+    deferred(false),
+    deferredAt(0),
     /* Allocate numCycles if an external stat wasn't passed in */
     numCyclesLocal((imported_num_cycles ? NULL : new Stats::Scalar)),
     numCycles((imported_num_cycles ? *imported_num_cycles :
@@ -74,13 +74,26 @@ class Ticked : public Serializable
         void
         process()
         {
-            ++owner.tickCycles;
-            ++owner.numCycles;
-            owner.countCycles(Cycles(1));
+            /* A deferred tick also accounts for the cycles skipped
+             *  since the tick which deferred it */
+            Cycles delta(1);
+            if (owner.deferred) {
+                delta = owner.object.curCycle() - owner.deferredAt;
+                owner.deferred = false;
+            }
+
+            owner.tickCycles += delta;
+            owner.numCycles += delta;
+            owner.countCycles(delta);
+            owner.nextTickDelay = Cycles(1);
             owner.evaluate();
             if (owner.running) {
                 owner.object.schedule(this,
-                    owner.object.clockEdge(Cycles(1)));
+                    owner.object.clockEdge(owner.nextTickDelay));
+                if (owner.nextTickDelay > 1) {
+                    owner.deferred = true;
+                    owner.deferredAt = owner.object.curCycle();
+                }
             }
         }
     };
@@ -99,6 +112,16 @@ class Ticked : public Serializable
     /** Time of last stop event to calculate run time */
     Cycles lastStopped;
 
+    /** Number of cycles from the current tick to the next one, as set
+     *  by deferTick */
+    Cycles nextTickDelay;
+
+    /** Is the next tick more than a cycle after the last one? */
+    bool deferred;
+
+    /** Cycle of the tick which deferred the next one */
+    Cycles deferredAt;
+
   private:
     /** Locally allocated stats */
     Stats::Scalar *numCyclesLocal;
@@ -124,7 +147,7 @@ class Ticked : public Serializable
      *  imported, be sure to register it *before* calling this regStats */
     void regStats();
 
-    /** Start ticking */
+    /** Start ticking, or bring a deferred tick forward */
     void
     start()
     {
@@ -134,9 +157,26 @@ class Ticked : public Serializable
             running = true;
             numCycles += cyclesSinceLastStopped();
             countCycles(cyclesSinceLastStopped());
+        } else if (deferred) {
+            /* Bring a deferred tick forward to the next clock edge, or
+             *  the one after that if the deferring tick was on this
+             *  edge */
+            Tick next_edge = object.clockEdge(
+                object.curCycle() == deferredAt ? Cycles(1) : Cycles(0));
+
+            if (event.when() > next_edge)
+                object.reschedule(event, next_edge);
         }
     }
 
+    /** Make the next tick happen delay cycles after the current one
+     *  rather than on the next cycle.  This must be called from
+     *  evaluate.  The cycles in between still count as ticked cycles,
+     *  so that the stats are the same as when ticking every cycle, and
+     *  calling start() before the next tick is due brings it forward
+     *  to the next clock edge */
+    void deferTick(Cycles delay) { nextTickDelay = delay; }
+
     /** How long have we been stopped for? */
     Cycles
     cyclesSinceLastStopped() const
@@ -159,6 +199,24 @@ class Ticked : public Serializable
             if (event.scheduled())
                 object.deschedule(event);
             running = false;
+
+            /* Account for the cycles since a deferring tick as they
+             *  won't be by the next one.  Ticking every cycle would
+             *  have counted the current cycle only if its tick had
+             *  already happened */
+            if (deferred) {
+                Cycles delta(0);
+                if (object.curCycle() > deferredAt) {
+                    bool ticked_now = object.eventQueue()->isServiced(
+                        object.clockEdge(), event.priority());
+                    delta = object.curCycle() - deferredAt -
+                        Cycles(ticked_now ? 0 : 1);
+                }
+                tickCycles += delta;
+                numCycles += delta;
+                countCycles(delta);
+                deferred = false;
+            }
             resetLastStopped();
         }
     }
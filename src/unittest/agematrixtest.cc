@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <deque>
+#include <map>
+#include <random>
+
+#include "cpu/o3/age_matrix.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+
+namespace {
+
+struct TestInst
+{
+    InstSeqNum seqNum;
+};
+
+typedef const TestInst *TestInstPtr;
+
+/** Op classes used by the test, few so that they get shared. */
+const int numTestClasses = 4;
+
+/**
+ * Insert, select, block and remove instructions at random, and check
+ * every select against a reference model of the list scheduler of the
+ * instruction queue: the ready instructions sorted by age, the oldest
+ * one whose op class is not blocked being selected.
+ *
+ * @param insert_pct Percentage of steps that insert an instruction
+ * @return Whether all selects picked the same instruction as the
+ * reference
+ */
+bool
+runRandom(unsigned init_slots, unsigned steps, unsigned insert_pct,
+          mt19937 &rng)
+{
+    AgeMatrix<TestInstPtr> matrix;
+    matrix.init(init_slots);
+
+    deque<TestInst> insts;
+    map<InstSeqNum, OpClass> ready;
+    InstSeqNum next_seq_num = 1;
+
+    for (unsigned step = 0; step < steps; ++step) {
+        if (ready.empty() || rng() % 100 < insert_pct) {
+            // instructions mostly become ready in program order, but
+            // not always
+            InstSeqNum seq_num = next_seq_num++;
+            if (rng() % 4 == 0 && seq_num > 20)
+                seq_num -= 1 + rng() % 20;
+            if (ready.count(seq_num))
+                continue;
+
+            OpClass op_class = OpClass(rng() % numTestClasses);
+            insts.push_back(TestInst{seq_num});
+            matrix.insert(&insts.back(), op_class);
+            ready[seq_num] = op_class;
+            continue;
+        }
+
+        // one select, issuing or blocking a few instructions
+        matrix.startSelect();
+        bool blocked[numTestClasses] = {};
+        unsigned num_issue = 1 + rng() % 4;
+        for (unsigned i = 0; i < num_issue; ++i) {
+            auto expected = ready.begin();
+            while (expected != ready.end() && blocked[expected->second])
+                ++expected;
+
+            int slot = matrix.selectOldest();
+            if (slot == -1) {
+                if (expected != ready.end())
+                    return false;
+                break;
+            }
+            if (expected == ready.end() ||
+                matrix.inst(slot)->seqNum != expected->first ||
+                matrix.opClass(slot) != expected->second)
+                return false;
+
+            if (rng() % 3 == 0) {
+                // no functional unit for this op class
+                blocked[expected->second] = true;
+                matrix.block(expected->second);
+            } else {
+                ready.erase(expected);
+                matrix.remove(slot);
+            }
+        }
+
+        for (int c = 0; c < numTestClasses; ++c)
+            EXPECT_EQ(matrix.size(OpClass(c)),
+                      count_if(ready.begin(), ready.end(),
+                               [c](const pair<InstSeqNum, OpClass> &r) {
+                                   return r.second == c;
+                               }));
+        EXPECT_EQ(matrix.empty(), ready.empty());
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    mt19937 rng(1);
+
+    UnitTest::setCase("Select matches the list scheduler");
+    EXPECT_TRUE(runRandom(128, 100000, 30, rng));
+
+    UnitTest::setCase("Select matches the list scheduler while growing");
+    EXPECT_TRUE(runRandom(1, 10000, 70, rng));
+
+    UnitTest::setCase("Reset");
+    {
+        AgeMatrix<TestInstPtr> matrix;
+        matrix.init(4);
+        TestInst insts[] = { {3}, {1}, {2} };
+        for (auto &inst : insts)
+            matrix.insert(&inst, OpClass(0));
+        matrix.reset();
+        EXPECT_TRUE(matrix.empty());
+        EXPECT_EQ(matrix.size(OpClass(0)), 0);
+        matrix.startSelect();
+        EXPECT_EQ(matrix.selectOldest(), -1);
+    }
+
+    return UnitTest::printResults();
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "base/blake2b.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+
+string
+digest(size_t out_len, const uint8_t *in, size_t in_len)
+{
+    uint8_t out[64];
+    blake2b(out, out_len, in, in_len);
+
+    string hex;
+    for (size_t i = 0; i < out_len; ++i) {
+        char byte[3];
+        snprintf(byte, sizeof(byte), "%02x", out[i]);
+        hex += byte;
+    }
+    return hex;
+}
+
+int
+main(int argc, char *argv[])
+{
+    uint8_t data[4096];
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = i;
+
+    UnitTest::setCase("RFC 7693 test vector");
+    EXPECT_EQ(digest(64, (const uint8_t *)"abc", 3),
+              "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdb"
+              "ffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab923"
+              "86edd4009923");
+
+    UnitTest::setCase("Empty input");
+    EXPECT_EQ(digest(32, data, 0),
+              "0e5751c026e543b2e8ab2eb06099daa1d1e5df47778f7787faab45cdf1"
+              "2fe3a8");
+
+    UnitTest::setCase("Single full block");
+    EXPECT_EQ(digest(32, data, 128),
+              "c3582f71ebb2be66fa5dd750f80baae97554f3b015663c8be377cfcb24"
+              "88c1d1");
+
+    UnitTest::setCase("Page");
+    EXPECT_EQ(digest(32, data, sizeof(data)),
+              "81baab4ea5d75a0aa53b8780ae5dbd7c8dac7f07e7c103644399492bb9"
+              "ea6f87");
+
+    return UnitTest::printResults();
+}
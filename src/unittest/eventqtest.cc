@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <random>
+#include <vector>
+
+#include "sim/eventq_impl.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+using UnitTest::setCase;
+
+namespace {
+
+class TestEvent : public Event
+{
+  public:
+    const int id;
+    vector<int> &trace;
+
+    TestEvent(int _id, Priority p, vector<int> &_trace)
+        : Event(p), id(_id), trace(_trace)
+    { }
+
+    void process() { trace.push_back(id); }
+    const char *description() const { return "test"; }
+};
+
+/**
+ * Drive two event queues with the same random sequence of schedule,
+ * deschedule and reschedule operations and record the order in which
+ * their events get serviced.
+ */
+struct QueuePair
+{
+    EventQueue listQ;
+    EventQueue calQ;
+    vector<int> listTrace;
+    vector<int> calTrace;
+    vector<TestEvent *> listEvents;
+    vector<TestEvent *> calEvents;
+
+    QueuePair(int num_events, mt19937 &rng)
+        : listQ("list", EventQueue::SortedList),
+          calQ("calendar", EventQueue::Calendar)
+    {
+        // Use few priorities so that bins get shared
+        const Event::Priority prios[] = {
+            Event::Default_Pri, Event::CPU_Tick_Pri, Event::Sim_Exit_Pri
+        };
+
+        for (int i = 0; i < num_events; ++i) {
+            Event::Priority p = prios[rng() % 3];
+            listEvents.push_back(new TestEvent(i, p, listTrace));
+            calEvents.push_back(new TestEvent(i, p, calTrace));
+        }
+    }
+
+    ~QueuePair()
+    {
+        for (size_t i = 0; i < listEvents.size(); ++i) {
+            if (listEvents[i]->scheduled())
+                listQ.deschedule(listEvents[i]);
+            if (calEvents[i]->scheduled())
+                calQ.deschedule(calEvents[i]);
+            delete listEvents[i];
+            delete calEvents[i];
+        }
+    }
+
+    void
+    randomOp(mt19937 &rng, Tick spread)
+    {
+        int i = rng() % listEvents.size();
+        Tick when = listQ.getCurTick() + rng() % spread;
+        if (!listEvents[i]->scheduled()) {
+            listQ.schedule(listEvents[i], when);
+            calQ.schedule(calEvents[i], when);
+        } else if (rng() % 2) {
+            listQ.deschedule(listEvents[i]);
+            calQ.deschedule(calEvents[i]);
+        } else {
+            listQ.reschedule(listEvents[i], when);
+            calQ.reschedule(calEvents[i], when);
+        }
+    }
+
+    void
+    serviceOne()
+    {
+        if (!listQ.empty())
+            listQ.serviceOne();
+        if (!calQ.empty())
+            calQ.serviceOne();
+    }
+
+    bool
+    sameState() const
+    {
+        return listTrace == calTrace && listQ.empty() == calQ.empty() &&
+            (listQ.empty() || listQ.nextTick() == calQ.nextTick());
+    }
+};
+
+} // anonymous namespace
+
+int
+main()
+{
+    mt19937 rng(1);
+
+    setCase("Calendar services events in sorted list order");
+    {
+        QueuePair qs(2000, rng);
+        for (int i = 0; i < 50000; ++i) {
+            qs.randomOp(rng, i % 1000 < 500 ? 16 : 100000);
+            if (rng() % 3 == 0)
+                qs.serviceOne();
+        }
+        EXPECT_TRUE(qs.calQ.debugVerify());
+        while (!qs.listQ.empty() || !qs.calQ.empty())
+            qs.serviceOne();
+        EXPECT_TRUE(qs.sameState());
+        EXPECT_TRUE(!qs.listTrace.empty());
+    }
+
+    setCase("Switching implementation keeps pending events");
+    {
+        QueuePair qs(500, rng);
+        for (int i = 0; i < 5000; ++i) {
+            qs.randomOp(rng, 1000);
+            if (i % 1000 == 0) {
+                EventQueue::Impl impl = qs.calQ.getImpl();
+                qs.calQ.setImpl(impl == EventQueue::Calendar ?
+                                EventQueue::SortedList : EventQueue::Calendar);
+                EXPECT_TRUE(qs.calQ.debugVerify());
+            }
+            if (rng() % 2)
+                qs.serviceOne();
+            EXPECT_TRUE(qs.sameState());
+        }
+    }
+
+    setCase("Replacing the head of a calendar queue");
+    {
+        QueuePair qs(100, rng);
+        for (int i = 0; i < 200; ++i)
+            qs.randomOp(rng, 100);
+
+        Event *list_head = qs.listQ.replaceHead(NULL);
+        Event *cal_head = qs.calQ.replaceHead(NULL);
+        EXPECT_TRUE(qs.listQ.empty());
+        EXPECT_TRUE(qs.calQ.empty());
+
+        cal_head = qs.calQ.replaceHead(cal_head);
+        list_head = qs.listQ.replaceHead(list_head);
+        EXPECT_TRUE(cal_head == NULL);
+        EXPECT_TRUE(qs.calQ.debugVerify());
+        while (!qs.listQ.empty() || !qs.calQ.empty())
+            qs.serviceOne();
+        EXPECT_TRUE(qs.sameState());
+    }
+
+    return UnitTest::printResults();
+}
@@ -0,0 +1,99 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# The same system as minor-timing, with stall skipping enabled. Skipping
+
+# The same system as simple-atomic, forked part of the way through the run. The
+# parent writes a binary stats dump before forking and the child checks
+# that its own binary stats file can be read back on its own. The parent
+# then runs to completion, so its stats are the same as those of
+# simple-atomic.
+
+import os
+import sys
+
+import m5
+from m5.objects import *
+from m5.stats.binary import BinaryStats
+from base_config import *
+
+root = BaseSESystemUniprocessor(mem_mode='atomic',
+                                cpu_class=AtomicSimpleCPU).create_root()
+
+def _check_child_stats(filename):
+    # the child inherits a binary stats output that already wrote its
+    # header and schema into the file of the parent
+    try:
+        dumps = list(BinaryStats(filename).dumps())
+    except ValueError, e:
+        return str(e)
+    if not dumps:
+        return "no dumps in %s" % filename
+    for dump in dumps:
+        if 'sim_ticks' not in dump:
+            return "dump @ tick %d in %s has no schema" % \
+                (dump.tick, filename)
+    return None
+
+def run_test(root):
+    m5.stats.initBinary('stats.bin')
+    binary = m5.stats.outputList[-1]
+
+    m5.instantiate()
+
+    # fork well before any of the hello world binaries exits
+    exit_event = m5.simulate(1000000)
+    if exit_event.getCause() != "simulate() limit reached":
+        print >> sys.stderr, "Test failed: exited before the fork"
+        sys.exit(1)
+
+    # dump only to the binary output, the text stats of the parent have
+    # to match those of simple-atomic
+    m5.stats.prepare()
+    binary.begin()
+    for stat in m5.stats.stats_list:
+        binary.visit(stat)
+    binary.end()
+
+    pid = m5.fork()
+    if pid == 0:
+        m5.simulate(maxtick)
+        m5.stats.dump()
+        error = _check_child_stats(
+            os.path.join(m5.options.outdir, 'stats.bin'))
+        if error:
+            print >> sys.stderr, "Test failed:", error
+        sys.stdout.flush()
+        sys.stderr.flush()
+        os._exit(1 if error else 0)
+
+    _, status = os.waitpid(pid, 0)
+    if status != 0:
+        print >> sys.stderr, "Test failed: the forked child failed"
+        sys.exit(1)
+
+    exit_event = m5.simulate(maxtick)
+    print 'Exiting @ tick', m5.curTick(), 'because', exit_event.getCause()
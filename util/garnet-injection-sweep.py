@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import optparse
+import os
+import re
+import subprocess
+import sys
+
+parser = optparse.OptionParser()
+
+# This script sweeps the injection rate of the Garnet synthetic
+# traffic generator (configs/example/ruby_network_test.py) on a mesh
+# using the fixed-pipeline network, and reports the host time and
+# simulation rate of each run. It is primarily meant to show how the
+# host cost of the network scales with the load, e.g. to evaluate
+# changes to the router pipeline.
+
+parser.add_option('-r', '--rates', type='string',
+                  default='0.01,0.02,0.05,0.1,0.2,0.3,0.4',
+                  help='Comma separated list of injection rates')
+parser.add_option('-n', '--num-nodes', type='int', default=64)
+parser.add_option('--mesh-rows', type='int', default=8)
+parser.add_option('--sim-cycles', type='int', default=100000)
+parser.add_option('--outdir', type='string', default='garnet-sweep')
+
+(options, args) = parser.parse_args()
+
+if len(args) != 1:
+    print "Error: Expecting a single argument specifying the gem5 binary"
+    sys.exit(1)
+
+gem5_binary = args[0]
+
+def stat(stats_file, name):
+    for line in open(stats_file):
+        m = re.match(r'%s\s+(\S+)' % re.escape(name), line)
+        if m:
+            return float(m.group(1))
+    return float('nan')
+
+print "%-8s %12s %12s %16s" % ("rate", "host_seconds", "sim_ticks",
+                                "host_tick_rate")
+
+for rate in options.rates.split(','):
+    outdir = os.path.join(options.outdir, 'rate-%s' % rate)
+    status = subprocess.call([gem5_binary, '-q', '--outdir=%s' % outdir,
+                              'configs/example/ruby_network_test.py',
+                              '--num-cpus=%d' % options.num_nodes,
+                              '--num-dirs=%d' % options.num_nodes,
+                              '--topology=Mesh',
+                              '--mesh-rows=%d' % options.mesh_rows,
+                              '--garnet-network=fixed',
+                              '--sim-cycles=%d' % options.sim_cycles,
+                              '--injectionrate=%s' % rate])
+    if status != 0:
+        print "Error: network test failed at injection rate %s\n" % rate
+        sys.exit(1)
+
+    stats_file = os.path.join(outdir, 'stats.txt')
+    print "%-8s %12.2f %12d %16d" % (rate,
+                                     stat(stats_file, 'host_seconds'),
+                                     stat(stats_file, 'sim_ticks'),
+                                     stat(stats_file, 'host_tick_rate'))